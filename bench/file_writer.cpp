@@ -0,0 +1,150 @@
+// Compares testcase_writer with the fputc-based file_writer it replaced.
+// g++ -std=c++14 -O2 -o file_writer bench/file_writer.cpp && ./file_writer [directory] [count]
+#define CAREFREE_INT128_SUPPORT
+#include "../carefree_linux.hpp"
+using namespace std;
+using namespace carefree;
+
+// testcase_writer::file_writer as of f0ae0cf, copied verbatim.
+class file_writer {
+private:
+    std::FILE* fp;
+    void _ein() {
+        if (fp == nullptr) raise(carefree_file_exception("testcase_writer::file_writer::_ein : file is not opened."));
+    }
+
+public:
+    string _filename;
+    file_writer() {}
+    file_writer(const char* filename) {
+        _filename = filename;
+        if (std::strlen(filename)) {
+            fp = std::fopen(filename, "w");
+            if (fp == NULL) raise(carefree_file_exception("testcase_writer::file_writer::file_writer : cannot open file " + _filename));
+        } else
+            fp = nullptr;
+    }
+    void close() {
+        if (fp != nullptr) std::fclose(fp);
+    }
+    ~file_writer() { close(); }
+    void writeChar(char val) {
+        _ein();
+        std::fputc(val, fp);
+    }
+    template <class T>
+    void writeInteger(T val) {
+        _ein();
+        if (val < 0) {
+            val = -val;
+            writeChar('-');
+        }
+        if (val == 0) {
+            writeChar('0');
+            return;
+        }
+        if (val >= 10) writeInteger(val / 10);
+        writeChar('0' + val % 10);
+    }
+    void writeString(const char* val) {
+        _ein();
+        const char* ptr = val;
+        while (*ptr != '\0') writeChar(*(ptr++));
+    }
+    void writeString(string val) {
+        _ein();
+        writeString(val.c_str());
+    }
+    void flush() {
+        _ein();
+        std::fflush(fp);
+    }
+};
+
+struct old_path {
+    file_writer writer;
+    old_path(const string& filename) : writer(filename.c_str()) {}
+    void put(char val) { writer.writeChar(val); }
+    void put(const string& val) { writer.writeString(val); }
+    template <class T>
+    void put(T val) { writer.writeInteger(val); }
+};
+
+struct new_path {
+    testcase_writer writer;
+    new_path(const string& filename) : writer(filename) {}
+    ~new_path() { writer.close(); }
+    template <class T>
+    void put(T val) { writer.input_write(val); }
+};
+
+template <class Path>
+double throughput(const string& filename, long long count) {
+    std::mt19937_64 engine(20240601);
+    std::uniform_int_distribution<int> distribution(-1000000000, 1000000000);
+    std::vector<int> value(1 << 20);
+    for (int& it : value) it = distribution(engine);
+    auto start = chrono::steady_clock::now();
+    {
+        Path path(filename);
+        for (long long i = 1; i <= count; i++) {
+            path.put(value[i & (value.size() - 1)]);
+            path.put(i % 10 ? ' ' : '\n');
+        }
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return carefree_internal::_file_size(filename) / 1e6 / elapsed;
+}
+
+template <class T>
+T above_min(T val) {
+    return val == std::numeric_limits<T>::min() ? T(val + 1) : val;
+}
+
+template <class Path>
+void corpus(const string& filename) {
+    std::mt19937_64 engine(20240602);
+    Path path(filename);
+    // the old writer negates before printing, so signed minimums overflow there; the corpus stays one above them.
+    path.put(std::numeric_limits<int>::min() + 1), path.put(' '), path.put(std::numeric_limits<int>::max()), path.put('\n');
+    path.put(std::numeric_limits<long long>::min() + 1), path.put(' '), path.put(std::numeric_limits<long long>::max()), path.put('\n');
+    path.put(std::numeric_limits<unsigned>::max()), path.put(' '), path.put(std::numeric_limits<unsigned long long>::max()), path.put('\n');
+    path.put((short)(std::numeric_limits<short>::min() + 1)), path.put(' '), path.put(std::numeric_limits<unsigned short>::max()), path.put('\n');
+    path.put(std::numeric_limits<__int128>::min() + 1), path.put(' '), path.put(std::numeric_limits<__int128>::max()), path.put(' '), path.put(~(unsigned __int128)0), path.put('\n');
+    for (int i = 0; i < 200000; i++) {
+        unsigned long long bits = engine();
+        int width = engine() % 63 + 1;
+        long long value = (long long)(bits >> (64 - width)) * (bits & 1 ? -1 : 1);
+        switch (engine() % 8) {
+            case 0: path.put(above_min((int)value)); break;
+            case 1: path.put(value); break;
+            case 2: path.put((unsigned)bits); break;
+            case 3: path.put(bits >> (engine() % 64)); break;
+            case 4: path.put((__int128)value * (long long)engine()); break;
+            case 5: path.put((unsigned __int128)bits * engine()); break;
+            case 6: path.put(string(engine() % 40, 'a' + i % 26)); break;
+            default: path.put(above_min((short)value)); break;
+        }
+        path.put(engine() % 8 ? ' ' : '\n');
+    }
+    path.put(string((1 << 21) + 7, 'x')), path.put('\n');
+}
+
+bool same_bytes(const string& a, const string& b) {
+    if (carefree_internal::_file_size(a) != carefree_internal::_file_size(b)) return false;
+    std::ifstream x(a, std::ios::binary), y(b, std::ios::binary);
+    return std::equal(std::istreambuf_iterator<char>(x), std::istreambuf_iterator<char>(), std::istreambuf_iterator<char>(y), std::istreambuf_iterator<char>());
+}
+
+signed main(int argc, char** argv) {
+    string directory = argc > 1 ? argv[1] : "/tmp";
+    long long count = argc > 2 ? atoll(argv[2]) : 100000000;
+    corpus<old_path>(directory + "/corpus_old.txt");
+    corpus<new_path>(directory + "/corpus_new.txt");
+    bool same = same_bytes(directory + "/corpus_old.txt", directory + "/corpus_new.txt");
+    printf("corpus (%llu bytes): %s\n", carefree_internal::_file_size(directory + "/corpus_old.txt"), same ? "byte-identical" : "DIFFERENT");
+    printf("fputc  %7.1f MB/s\n", throughput<old_path>(directory + "/throughput_old.txt", count));
+    printf("buffer %7.1f MB/s\n", throughput<new_path>(directory + "/throughput_new.txt", count));
+    for (string name : {"corpus_old", "corpus_new", "throughput_old", "throughput_new"}) std::remove((directory + "/" + name + ".txt").c_str());
+    return same ? 0 : 1;
+}
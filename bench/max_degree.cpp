@@ -0,0 +1,61 @@
+// Compares stream_max_degree with the pbds-based generator it replaced.
+// g++ -std=c++14 -O2 -o max_degree bench/max_degree.cpp && ./max_degree [n] [samples]
+#include "../carefree_linux.hpp"
+using namespace std;
+using namespace carefree;
+
+template <class Sink>
+void pbds_max_degree(Sink&& sink, int n, int k) {
+    carefree_internal::BalancedTree<pair<int, int>> tree;
+    tree.insert({1, 0});
+    for (int i = 2; i <= n; i++) {
+        auto fa = tree.kth(randint(1, tree.size()));
+        tree.erase(fa);
+        if (fa.second < k) tree.insert({fa.first, fa.second + 1});
+        sink(fa.first, i, carefree_internal::no_weight());
+        tree.insert({i, 0});
+    }
+}
+
+template <class Generator>
+double seconds(Generator generate, unsigned long long& checksum) {
+    auto start = chrono::steady_clock::now();
+    generate([&](int u, int v, carefree_internal::no_weight) { checksum += (unsigned long long)u * v; });
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+template <class Generator>
+map<long long, long long> histogram(Generator generate, int n, int samples) {
+    map<long long, long long> count;
+    vector<int> parent(n + 1);
+    for (int s = 0; s < samples; s++) {
+        generate([&](int u, int v, carefree_internal::no_weight) { parent[v] = u; });
+        long long key = 0;
+        for (int v = 2; v <= n; v++) key = key * n + parent[v];
+        count[key]++;
+    }
+    return count;
+}
+
+signed main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 10000000, samples = argc > 2 ? atoi(argv[2]) : 200000;
+    unsigned long long checksum = 0;
+    for (int k : {1, 3, 100}) {
+        double old_time = seconds([&](auto&& sink) { pbds_max_degree(sink, n, k); }, checksum);
+        double new_time = seconds([&](auto&& sink) { stream_max_degree(sink, n, k, weights::none()); }, checksum);
+        printf("n = %d, k = %-3d  pbds %7.2f s  array %7.2f s\n", n, k, old_time, new_time);
+    }
+    const int small = 5, k = 1;
+    auto old_count = histogram([&](auto&& sink) { pbds_max_degree(sink, small, k); }, small, samples);
+    auto new_count = histogram([&](auto&& sink) { stream_max_degree(sink, small, k, weights::none()); }, small, samples);
+    set<long long> trees;
+    for (auto& it : old_count) trees.insert(it.first);
+    for (auto& it : new_count) trees.insert(it.first);
+    double chi = 0;
+    for (long long key : trees) {
+        double a = old_count.count(key) ? old_count[key] : 0, b = new_count.count(key) ? new_count[key] : 0;
+        chi += (a - b) * (a - b) / (a + b);
+    }
+    printf("n = %d, k = %d, %d samples each: %zu / %zu / %zu distinct trees, two-sample chi-square %.1f (df %zu)\n", small, k, samples, old_count.size(), new_count.size(), trees.size(), chi, trees.size() - 1);
+    printf("checksum %llu\n", checksum);
+}
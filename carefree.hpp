@@ -29,33 +29,56 @@
 #define CAREFREE_VERSION_MINOR 7
 #define CAREFREE_VERSION "0.7"
 
+#include <fcntl.h>
 #include <io.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
+#ifndef O_CLOEXEC
+#define O_CLOEXEC O_NOINHERIT
+#endif
+
 #include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <deque>
 #include <ext/pb_ds/assoc_container.hpp>
 #include <ext/pb_ds/tree_policy.hpp>
 #include <fstream>
 #include <initializer_list>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <queue>
 #include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <type_traits>
 #include <typeinfo>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wliteral-suffix"
 
@@ -246,68 +269,57 @@ namespace carefree_internal {
 
     template <class T>
     void err_range_checker(T l, T r, string func_name) {
-        string errmsg = func_name + " : " + "l(" + std::to_string(l) + ") > r(" + std::to_string(r) + ").";
-        if (l > r) raise(carefree_range_exception(errmsg));
+        if (l > r) raise(carefree_range_exception(func_name + " : " + "l(" + std::to_string(l) + ") > r(" + std::to_string(r) + ")."));
     }
 
     template <class T>
     void err_unempty_checker(T x, string func_name, string var_name) {
-        string errmsg = func_name + " : " + var_name + " is empty.";
-        if (x.empty()) raise(carefree_invalid_argument(errmsg));
+        if (x.empty()) raise(carefree_invalid_argument(func_name + " : " + var_name + " is empty."));
     }
 
     template <class T>
     void err_positive_checker(T x, string func_name, string var_name) {
-        string errmsg = func_name + " : " + var_name + "(" + std::to_string(x) + ") is not positive.";
-        if (x <= 0) raise(carefree_invalid_argument(errmsg));
+        if (x <= 0) raise(carefree_invalid_argument(func_name + " : " + var_name + "(" + std::to_string(x) + ") is not positive."));
     }
 
     template <class T>
     void err_natural_checker(T x, string func_name, string var_name) {
-        string errmsg = func_name + " : " + var_name + "(" + std::to_string(x) + ") is not natural.";
-        if (x < 0) raise(carefree_invalid_argument(errmsg));
+        if (x < 0) raise(carefree_invalid_argument(func_name + " : " + var_name + "(" + std::to_string(x) + ") is not natural."));
     }
 
     template <class T>
     void err_inrange_checker(T x, T l, T r, string func_name, string var_name) {
-        string errmsg = func_name + " : " + var_name + "(" + std::to_string(x) + ") is not in range [" + std::to_string(l) + ", " + std::to_string(r) + "].";
-        if (x < l || x > r) raise(carefree_range_exception(errmsg));
+        if (x < l || x > r) raise(carefree_range_exception(func_name + " : " + var_name + "(" + std::to_string(x) + ") is not in range [" + std::to_string(l) + ", " + std::to_string(r) + "]."));
     }
 
     template <class T>
     void err_less_checker(T x, T l, string func_name, string var_name) {
-        string errmsg = func_name + " : " + var_name + "(" + std::to_string(x) + ") is not less than " + std::to_string(l) + ".";
-        if (x >= l) raise(carefree_range_exception(errmsg));
+        if (x >= l) raise(carefree_range_exception(func_name + " : " + var_name + "(" + std::to_string(x) + ") is not less than " + std::to_string(l) + "."));
     }
 
     template <class T>
     void err_greater_checker(T x, T l, string func_name, string var_name) {
-        string errmsg = func_name + " : " + var_name + "(" + std::to_string(x) + ") is not greater than " + std::to_string(l) + ".";
-        if (x <= l) raise(carefree_range_exception(errmsg));
+        if (x <= l) raise(carefree_range_exception(func_name + " : " + var_name + "(" + std::to_string(x) + ") is not greater than " + std::to_string(l) + "."));
     }
 
     template <class T>
     void err_leq_checker(T x, T l, string func_name, string var_name) {
-        string errmsg = func_name + " : " + var_name + "(" + std::to_string(x) + ") is not less than or equal to " + std::to_string(l) + ".";
-        if (x > l) raise(carefree_range_exception(errmsg));
+        if (x > l) raise(carefree_range_exception(func_name + " : " + var_name + "(" + std::to_string(x) + ") is not less than or equal to " + std::to_string(l) + "."));
     }
 
     template <class T>
     void err_geq_checker(T x, T l, string func_name, string var_name) {
-        string errmsg = func_name + " : " + var_name + "(" + std::to_string(x) + ") is not greater than or equal to " + std::to_string(l) + ".";
-        if (x < l) raise(carefree_range_exception(errmsg));
+        if (x < l) raise(carefree_range_exception(func_name + " : " + var_name + "(" + std::to_string(x) + ") is not greater than or equal to " + std::to_string(l) + "."));
     }
 
     template <class T>
     void err_equal_checker(T x, T l, string func_name, string var_name) {
-        string errmsg = func_name + " :" + var_name + "(" + std::to_string(x) + ") is not equal to " + std::to_string(l) + ".";
-        if (x != l) raise(carefree_range_exception(errmsg));
+        if (x != l) raise(carefree_range_exception(func_name + " :" + var_name + "(" + std::to_string(x) + ") is not equal to " + std::to_string(l) + "."));
     }
 
     template <class T>
     void err_unequal_checker(T x, T l, string func_name, string var_name) {
-        string errmsg = func_name + " : " + var_name + "(" + std::to_string(x) + ") is not unequal to " + std::to_string(l) + ".";
-        if (x == l) raise(carefree_range_exception(errmsg));
+        if (x == l) raise(carefree_range_exception(func_name + " : " + var_name + "(" + std::to_string(x) + ") is not unequal to " + std::to_string(l) + "."));
     }
 
     void set_exception_policy(exception_policy policy) {
@@ -322,22 +334,142 @@ namespace carefree_internal {
         return string(a) + string(b);
     }
 
+    const char* _digit_pairs() {
+        return "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+               "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+               "8081828384858687888990919293949596979899";
+    }
+
+    char* _format_unsigned(unsigned val, char* end) {
+        const char* pairs = _digit_pairs();
+        while (val >= 100) {
+            unsigned r = val % 100;
+            val /= 100;
+            end -= 2;
+            std::memcpy(end, pairs + r * 2, 2);
+        }
+        if (val >= 10) {
+            end -= 2;
+            std::memcpy(end, pairs + val * 2, 2);
+        } else
+            *(--end) = char('0' + val);
+        return end;
+    }
+
+    char* _format_fixed(unsigned val, char* end) {
+        const char* pairs = _digit_pairs();
+        for (int i = 0; i < 4; i++) {
+            end -= 2;
+            std::memcpy(end, pairs + (val % 100) * 2, 2);
+            val /= 100;
+        }
+        return end;
+    }
+
+    char* _format_unsigned(unsigned long long val, char* end) {
+        while (val >= 100000000ULL) {
+            end = _format_fixed(unsigned(val % 100000000ULL), end);
+            val /= 100000000ULL;
+        }
+        return _format_unsigned(unsigned(val), end);
+    }
+
+#ifdef CAREFREE_INT128_SUPPORT
+    char* _format_unsigned(unsigned __int128 val, char* end) {
+        const unsigned long long base = 10000000000000000000ULL;
+        while (val > ~0ULL) {
+            char* low = end - 19;
+            char* ptr = _format_unsigned((unsigned long long)(val % base), end);
+            while (ptr != low) *(--ptr) = '0';
+            end = low;
+            val /= base;
+        }
+        return _format_unsigned((unsigned long long)val, end);
+    }
+#endif
+
+    const unsigned long long _pow10_table[] = {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL};
+
+    template <class T, class Result = void>
+    using _if_floating = typename std::enable_if<std::is_floating_point<T>::value, Result>::type;
+
+    template <class T, class Result = void>
+    using _if_integer = typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value, Result>::type;
+
+    template <class T, class = void>
+    struct _is_range : std::false_type {};
+
+    template <class T>
+    struct _is_range<T, decltype(void(std::begin(std::declval<const T&>())), void(std::end(std::declval<const T&>())))> : std::integral_constant<bool, !std::is_convertible<const T&, string>::value> {};
+
+    template <class T, class Result = void>
+    using _if_range = typename std::enable_if<_is_range<T>::value, Result>::type;
+
+    template <class T>
+    size_t _float_length_bound(unsigned precision) {
+        return std::numeric_limits<T>::max_exponent10 + precision + 8;
+    }
+
+    char* _format_float_fast(double val, unsigned precision, char* out) {
+        double magnitude = std::fabs(val);
+        if (precision > 12 || !(magnitude < 1e15)) return nullptr;
+        unsigned long long scale = _pow10_table[precision];
+        double integer = std::floor(magnitude), scaled = (magnitude - integer) * scale, low = std::floor(scaled);
+        if (std::fabs(scaled - low - 0.5) < 1e-6 + scaled * 1e-15) return nullptr;
+        unsigned long long whole = (unsigned long long)integer, fraction = (unsigned long long)low + (scaled - low > 0.5);
+        if (fraction == scale) {
+            whole++;
+            fraction = 0;
+        }
+        char digits[32], *end = digits + sizeof(digits), *ptr = end;
+        if (precision) {
+            for (unsigned i = 0; i < precision; i++) {
+                *(--ptr) = char('0' + fraction % 10);
+                fraction /= 10;
+            }
+            *(--ptr) = '.';
+        }
+        ptr = _format_unsigned(whole, ptr);
+        if (std::signbit(val)) *(--ptr) = '-';
+        std::memcpy(out, ptr, end - ptr);
+        return out + (end - ptr);
+    }
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    template <class T>
+    char* _format_float_exact(T val, unsigned precision, char* out) {
+        return std::to_chars(out, out + _float_length_bound<T>(precision), val, std::chars_format::fixed, int(precision)).ptr;
+    }
+#else
+    char* _format_float_exact(double val, unsigned precision, char* out) {
+        return out + std::snprintf(out, _float_length_bound<double>(precision), "%.*f", int(precision), val);
+    }
+
+    char* _format_float_exact(long double val, unsigned precision, char* out) {
+        return out + std::snprintf(out, _float_length_bound<long double>(precision), "%.*Lf", int(precision), val);
+    }
+#endif
+
+    char* _format_float(double val, unsigned precision, char* out) {
+        char* end = _format_float_fast(val, precision, out);
+        return end != nullptr ? end : _format_float_exact(val, precision, out);
+    }
+
+    char* _format_float(float val, unsigned precision, char* out) {
+        return _format_float(double(val), precision, out);
+    }
+
+    char* _format_float(long double val, unsigned precision, char* out) {
+        return _format_float_exact(val, precision, out);
+    }
+
     template <class T>
     string __fts(T val, unsigned precision = 10) {
-        static char buffer[255], buffer2[2047];
-        if (std::is_same<T, float>::value)
-            sprintf(buffer, "%%.%df", precision);
-        else if (std::is_same<T, double>::value)
-            sprintf(buffer, "%%.%dlf", precision);
-        else if (std::is_same<T, long double>::value)
-            sprintf(buffer, "%%.%dlf", precision);
-        else {
-            const std::type_info& x = typeid(T);
-            raise(carefree_invalid_argument(join_str("__fts : unsupport type ", x.name()).c_str()));
-        }
-        sprintf(buffer2, buffer, val);
-        string str(buffer2);
-        return str;
+        size_t bound = _float_length_bound<T>(precision);
+        char local[384];
+        std::unique_ptr<char[]> heap(bound > sizeof(local) ? new char[bound] : nullptr);
+        char* buffer = heap ? heap.get() : local;
+        return string(buffer, _format_float(val, precision, buffer));
     }
 
     string fts(float val, unsigned precision = 10) {
@@ -569,15 +701,195 @@ namespace carefree_internal {
         bool empty() { return tree.empty(); }
     };
 
+    struct dense_keys {};
+
+    template <class T>
+    class BalancedTree<T, dense_keys> {
+        static_assert(std::is_integral<T>::value, "BalancedTree<T, dense_keys> needs an integral key type.");
+
+    private:
+        using key_bits = std::make_unsigned_t<T>;
+
+        T lo, hi;
+        int count;
+        std::vector<int> fenwick;
+        std::vector<unsigned long long> present;
+        size_t top;
+
+        // differences are taken in the unsigned type (and cast back, since short keys promote to int) so that ranges such as [INT_MIN, INT_MAX] do not overflow.
+        static size_t _universe(T lo, T hi) {
+            err_range_checker(lo, hi, "BalancedTree");
+            key_bits span = (key_bits)hi - (key_bits)lo;
+            if (span >= std::numeric_limits<size_t>::max() - 1) raise(carefree_invalid_argument("BalancedTree : key range is too wide."));
+            return (size_t)span + 1;
+        }
+
+        size_t _index(T x) const { return (size_t)(key_bits)((key_bits)x - (key_bits)lo); }
+
+        bool _test(size_t i) const { return present[i >> 6] >> (i & 63) & 1; }
+
+        void _flip(size_t i) { present[i >> 6] ^= 1ull << (i & 63); }
+
+        void _add(size_t i, int delta) {
+            for (i++; i < fenwick.size(); i += i & -i) fenwick[i] += delta;
+        }
+
+    public:
+        BalancedTree(T lo, T hi) : lo(lo), hi(hi), count(0), fenwick(_universe(lo, hi) + 1), present(((fenwick.size() - 1) >> 6) + 1), top(1) {
+            while (top * 2 < fenwick.size()) top <<= 1;
+        }
+
+        template <class Iterator>
+        BalancedTree(T lo, T hi, Iterator first, Iterator last) : BalancedTree(lo, hi) {
+            for (Iterator it = first; it != last; ++it) {
+                err_inrange_checker(T(*it), lo, hi, "BalancedTree", "key");
+                size_t i = _index(T(*it));
+                if (_test(i)) continue;
+                _flip(i);
+                fenwick[i + 1] = 1;
+                count++;
+            }
+            for (size_t i = 1; i < fenwick.size(); i++) {
+                size_t j = i + (i & -i);
+                if (j < fenwick.size()) fenwick[j] += fenwick[i];
+            }
+        }
+
+        void insert(T x) {
+            err_inrange_checker(x, lo, hi, "BalancedTree::insert", "x");
+            size_t i = _index(x);
+            if (_test(i)) return;
+            _flip(i);
+            _add(i, 1);
+            count++;
+        }
+
+        bool erase(T x) {
+            if (x < lo || x > hi || !_test(_index(x))) return false;
+            _flip(_index(x));
+            _add(_index(x), -1);
+            count--;
+            return true;
+        }
+
+        int rnk(T x) {
+            if (x <= lo) return 1;
+            if (x > hi) return count + 1;
+            int ret = 1;
+            for (size_t i = _index(x); i; i -= i & -i) ret += fenwick[i];
+            return ret;
+        }
+
+        T kth(int x) {
+            err_inrange_checker(x, 1, count, "BalancedTree::kth", "x");
+            size_t pos = 0;
+            for (size_t step = top; step; step >>= 1) {
+                if (pos + step < fenwick.size() && fenwick[pos + step] < x) {
+                    pos += step;
+                    x -= fenwick[pos];
+                }
+            }
+            return T((key_bits)lo + (key_bits)pos);
+        }
+
+        int size() { return count; }
+
+        bool empty() { return !count; }
+    };
+
     using _Weight = long long;
 
-    class graph {
+    struct no_weight {};
+
+    template <class Weight, class = void>
+    struct _weight_field {
+        Weight weight;
+        _weight_field() {}
+        _weight_field(Weight weight) : weight(weight) {}
+    };
+
+    template <class Tag>
+    struct _weight_field<no_weight, Tag> {
+        static no_weight weight;
+        _weight_field() {}
+        _weight_field(no_weight) {}
+    };
+
+    template <class Tag>
+    no_weight _weight_field<no_weight, Tag>::weight;
+
+    template <class Weight = _Weight, class Index = int>
+    struct basic_edge : _weight_field<Weight> {
+        Index from, to;
+        basic_edge(Index from, Index to, Weight weight = Weight()) : _weight_field<Weight>(weight), from(from), to(to) {}
+    };
+
+    template <class Weight, class Index>
+    class basic_csr;
+
+    template <class Weight, class Index>
+    class basic_mapped_graph;
+
+    struct _binary_graph_header {
+        char magic[8];
+        unsigned version, flags, weight_size, index_size;
+        unsigned long long byte_order, n, edge_count, adj_count;
+    };
+
+    const unsigned _binary_graph_version = 2;
+
+    const unsigned long long _binary_byte_order = 0x0102030405060708ull;
+
+    size_t _binary_padded(size_t bytes) {
+        return (bytes + 7) & ~size_t(7);
+    }
+
+    // moves at past count padded elements of the given size, failing instead of overflowing size_t.
+    bool _binary_advance(size_t& at, unsigned long long count, size_t size) {
+        size_t room = std::numeric_limits<size_t>::max() - 7;
+        if (at > room || count > (room - at) / size) return false;
+        at += _binary_padded(count * size);
+        return true;
+    }
+
+    void _binary_write(FILE* file, const void* data, size_t bytes, const string& path) {
+        static const char zero[8] = {};
+        if ((bytes && fwrite(data, 1, bytes, file) != bytes) || fwrite(zero, 1, _binary_padded(bytes) - bytes, file) != _binary_padded(bytes) - bytes) {
+            fclose(file);
+            raise(carefree_file_exception("save_binary : failed to write file " + path));
+        }
+    }
+
+    // edges are copied field by field into zeroed records, so the padding inside basic_edge is written as zeros.
+    template <class Weight, class Index>
+    void _binary_write_edges(FILE* file, const std::vector<basic_edge<Weight, Index>>& edges, const string& path) {
+        std::vector<basic_edge<Weight, Index>> staging(std::min<size_t>(edges.size(), 4096), basic_edge<Weight, Index>(0, 0));
+        for (size_t i = 0; i < edges.size(); i += staging.size()) {
+            size_t count = std::min(staging.size(), edges.size() - i);
+            std::memset((void*)staging.data(), 0, count * sizeof(basic_edge<Weight, Index>));
+            for (size_t j = 0; j < count; j++) {
+                staging[j].from = edges[i + j].from;
+                staging[j].to = edges[i + j].to;
+                staging[j].weight = edges[i + j].weight;
+            }
+            _binary_write(file, staging.data(), count * sizeof(basic_edge<Weight, Index>), path);
+        }
+    }
+
+    // vertices are 0..n; a negative signed index converts to a value above any valid n.
+    template <class Index>
+    bool _binary_vertex(Index u, unsigned long long n) {
+        return (unsigned long long)u <= n;
+    }
+
+    template <class Weight = _Weight, class Index = int>
+    class basic_graph {
     public:
-        struct edge {
-            int from, to;
-            _Weight weight;
-            edge(int from, int to, _Weight weight = 0) : from(from), to(to), weight(weight) {}
-        };
+        using weight_type = Weight;
+
+        using index_type = Index;
+
+        using edge = basic_edge<Weight, Index>;
 
         struct weighted_output {
             string operator()(edge edg) {
@@ -592,53 +904,136 @@ namespace carefree_internal {
         };
 
     private:
-        struct chain_node {
-            int nxt, to;
-            _Weight w;
+        struct chain_node : _weight_field<Weight> {
+            Index nxt, to;
             chain_node() {}
-            chain_node(int nxt, int to, _Weight w) : nxt(nxt), to(to), w(w) {}
+            chain_node(Index nxt, Index to, Weight weight) : _weight_field<Weight>(weight), nxt(nxt), to(to) {}
         };
         std::vector<chain_node> chain;
-        std::vector<int> head;
-        std::vector<std::map<int, bool>> edge_map;
+        std::vector<Index> head;
+        std::vector<std::map<Index, bool>> edge_map;
         std::vector<edge> edge_vct;
 
     public:
-        int N;
+        Index N;
 
         bool directed;
 
         bool enable_edge_map;
 
-        graph(int N, bool directed = false, bool enable_edge_map = true) {
+        basic_graph(Index N, bool directed = false, bool enable_edge_map = true) {
             err_positive_checker(N, __func__, "N");
             this->N = N;
             this->directed = directed;
             this->enable_edge_map = enable_edge_map;
-            head = std::vector<int>(N + 1, -1);
-            edge_map = std::vector<std::map<int, bool>>(N + 1);
+            head = std::vector<Index>(N + 1, Index(-1));
+        }
+
+    private:
+        void _link(Index from, Index to, Weight weight) {
+            chain.push_back(chain_node(head[from], to, weight));
+            head[from] = chain.size() - 1;
+            if (!edge_map.empty()) edge_map[from][to] = true;
+        }
+
+        void _check_vertex(Index u, const char* func_name, const char* var_name) const {
+            if (u < 0 || u > N) err_inrange_checker(u, Index(0), N, func_name, var_name);
+        }
+
+        template <class Iterator>
+        void _check_edges(Iterator first, Iterator last) const {
+            Index low = 0, high = 0;
+            for (Iterator it = first; it != last; ++it) {
+                low = std::min(low, std::min(it->from, it->to));
+                high = std::max(high, std::max(it->from, it->to));
+            }
+            if (low >= 0 && high <= N) return;
+            for (Iterator it = first; it != last; ++it) {
+                _check_vertex(it->from, "add_edges", "edg.from");
+                _check_vertex(it->to, "add_edges", "edg.to");
+            }
+        }
+
+        void _build_adjacency() {
+            std::vector<Index> start(N + 2);
+            for (auto& i : edge_vct) {
+                start[i.from + 1]++;
+                if (!directed) start[i.to + 1]++;
+            }
+            for (Index i = 0; i <= N; i++) start[i + 1] += start[i];
+            chain.resize(start[N + 1]);
+            for (auto& i : edge_vct) {
+                chain[start[i.from]] = chain_node(head[i.from], i.to, i.weight);
+                head[i.from] = start[i.from]++;
+                if (!directed) {
+                    chain[start[i.to]] = chain_node(head[i.to], i.from, i.weight);
+                    head[i.to] = start[i.to]++;
+                }
+            }
+            if (!edge_map.empty()) {
+                for (auto& i : edge_vct) {
+                    edge_map[i.from][i.to] = true;
+                    if (!directed) edge_map[i.to][i.from] = true;
+                }
+            }
+        }
+
+    public:
+        void reserve(size_t m) {
+            edge_vct.reserve(m);
+            chain.reserve(directed ? m : m * 2);
         }
 
         void add(edge edg, bool __add_vector = true) {
-            err_inrange_checker(edg.from, 0, N, __func__, "edg.from");
-            err_inrange_checker(edg.to, 0, N, __func__, "edg.to");
-            chain.push_back(chain_node(head[edg.from], edg.to, edg.weight));
-            head[edg.from] = chain.size() - 1;
-            if (!directed && __add_vector) add(edge(edg.to, edg.from, edg.weight), false);
+            _check_vertex(edg.from, __func__, "edg.from");
+            _check_vertex(edg.to, __func__, "edg.to");
+            _link(edg.from, edg.to, edg.weight);
+            if (!directed && __add_vector) _link(edg.to, edg.from, edg.weight);
             if (__add_vector) edge_vct.push_back(edg);
-            if (enable_edge_map) edge_map[edg.from][edg.to] = true;
         }
 
-        void add(int from, int to, _Weight weight = 0) {
+        template <class Iterator>
+        void add_edges(Iterator first, Iterator last) {
+            _check_edges(first, last);
+            if (edge_vct.empty() && chain.empty()) {
+                edge_vct.assign(first, last);
+                _build_adjacency();
+                return;
+            }
+            for (Iterator it = first; it != last; ++it) {
+                _link(it->from, it->to, it->weight);
+                if (!directed) _link(it->to, it->from, it->weight);
+                edge_vct.push_back(*it);
+            }
+        }
+
+        void add_edges(const std::vector<edge>& edges) {
+            add_edges(edges.begin(), edges.end());
+        }
+
+        void add_edges(std::vector<edge>&& edges) {
+            if (!edge_vct.empty() || !chain.empty()) return add_edges(edges.begin(), edges.end());
+            _check_edges(edges.begin(), edges.end());
+            edge_vct = std::move(edges);
+            _build_adjacency();
+        }
+
+        void add(Index from, Index to, Weight weight = Weight()) {
             add(edge(from, to, weight));
         }
 
         bool has_edge(edge edg) {
             if (!enable_edge_map) raise(carefree_unsupported_operation("has_edge : edge map is not enabled"));
+            if (edge_map.empty()) {
+                edge_map.resize(N + 1);
+                for (Index u = 0; u <= N; u++) {
+                    for (Index i = head[u]; ~i; i = chain[i].nxt) edge_map[u][chain[i].to] = true;
+                }
+            }
             return edge_map[edg.from][edg.to];
         }
 
-        bool has_edge(int from, int to) {
+        bool has_edge(Index from, Index to) {
             return has_edge(edge(from, to));
         }
 
@@ -646,10 +1041,19 @@ namespace carefree_internal {
             return edge_vct;
         }
 
-        std::vector<edge> get_edges(int from) {
-            err_inrange_checker(from, 0, N, __func__, "from");
+        const std::vector<edge>& edges() const {
+            return edge_vct;
+        }
+
+        template <class Function>
+        void for_each_adjacent(Index from, Function function) const {
+            for (Index i = head[from]; ~i; i = chain[i].nxt) function(chain[i].to, chain[i].weight);
+        }
+
+        std::vector<edge> get_edges(Index from) {
+            err_inrange_checker(from, Index(0), N, __func__, "from");
             std::vector<edge> edges;
-            for (int i = head[from]; ~i; i = chain[i].nxt) edges.push_back(edge(from, chain[i].to, chain[i].w));
+            for (Index i = head[from]; ~i; i = chain[i].nxt) edges.push_back(edge(from, chain[i].to, chain[i].weight));
             return edges;
         }
 
@@ -664,347 +1068,3377 @@ namespace carefree_internal {
             }
             return str;
         }
-    };
-
-    using edge = graph::edge;
-
-    using weighted_output = graph::weighted_output;
-
-    using unweighted_output = graph::unweighted_output;
 
-    bool is_tree(graph g) {
-        std::vector<int> fa(g.N + 1);
-        for (int i = 1; i <= g.N; i++) fa[i] = i;
-        auto edges = g.get_edges();
-        if (edges.size() != (unsigned)(g.N - 1)) return false;
-        std::function<int(int)> find = [&](int x) {
-            return fa[x] == x ? x : fa[x] = find(fa[x]);
-        };
-        for (auto i : edges) {
-            int u = i.from, v = i.to;
-            if (find(u) == find(v)) return false;
-            fa[find(u)] = find(v);
+        std::vector<edge> release_edges() {
+            std::vector<edge> edges = std::move(edge_vct);
+            edge_vct.clear();
+            chain.clear();
+            head.assign(N + 1, Index(-1));
+            edge_map.clear();
+            return edges;
         }
-        return true;
-    }
 
-    graph relabel(graph g) {
-        std::vector<int> perm;
-        for (int i = 1; i <= g.N; i++) perm.push_back(i);
-        std::shuffle(perm.begin(), perm.end(), public_random_engine);
-        graph new_(g.N, g.directed, g.enable_edge_map);
-        for (auto i : g.get_edges()) {
-            new_.add(perm[i.from - 1], perm[i.to - 1], i.weight);
+        template <class Function>
+        void modify_edges(Function function) {
+            function(edge_vct);
+            chain.clear();
+            head.assign(N + 1, Index(-1));
+            edge_map.clear();
+            _build_adjacency();
         }
-        return new_;
-    }
 
-    graph prufer_decode(int n, std::vector<int> prufer, _Weight weightL = 0, _Weight weightR = 0) {
-        std::vector<int> deg(n + 1, 1);
-        prufer.insert(prufer.begin(), 0);
-        graph g(n, false);
-        if (prufer.size() != (unsigned)(n - 1)) raise(carefree_invalid_argument("prufer_decode : prufer size must be n-1"));
-        for (int i = 1; i <= (n - 2); i++) {
-            err_inrange_checker(prufer[i], 1, n, __func__, "prufer[" + std::to_string(i) + "]");
-        }
-        for (int i = 1; i <= (n - 2); i++) deg[prufer[i]]++;
-        int ptr = 1, leaf = 0;
-        while (deg[ptr] != 1) ptr++;
-        leaf = ptr;
-        for (int i = 1; i <= (n - 2); i++) {
-            int v = prufer[i];
-            g.add(v, leaf, randint(weightL, weightR));
-            if (--deg[v] == 1 && v < ptr)
-                leaf = v;
-            else {
-                ptr++;
-                while (deg[ptr] != 1) ptr++;
-                leaf = ptr;
-            }
+        void save_binary(const string& path) const {
+            basic_csr<Weight, Index> csr(*this);
+            FILE* file = fopen(path.c_str(), "wb");
+            if (file == nullptr) raise(carefree_file_exception("save_binary : cannot open file " + path));
+            bool weighted = !std::is_same<Weight, no_weight>::value;
+            _binary_graph_header header = {{'C', 'F', 'G', 'R', 'A', 'P', 'H', '\0'}, _binary_graph_version, directed, weighted ? (unsigned)sizeof(Weight) : 0, (unsigned)sizeof(Index), _binary_byte_order, (unsigned long long)N, edge_vct.size(), csr.adj.size()};
+            _binary_write(file, &header, sizeof(header), path);
+            _binary_write(file, csr.offset.data(), csr.offset.size() * sizeof(unsigned long long), path);
+            _binary_write(file, csr.adj.data(), csr.adj.size() * sizeof(Index), path);
+            if (weighted) _binary_write(file, csr.weight.data(), csr.weight.size() * sizeof(Weight), path);
+            _binary_write_edges(file, edge_vct, path);
+            if (fclose(file)) raise(carefree_file_exception("save_binary : failed to close file " + path));
         }
-        g.add(n, leaf, randint(weightL, weightR));
-        return g;
-    }
 
-    std::vector<int> get_depth(graph g) {
-        std::queue<int> q;
-        std::vector<int> depth(g.N + 1);
-        q.push(1);
-        depth[1] = 1;
-        while (!q.empty()) {
-            auto u = q.front();
-            q.pop();
-            for (auto i : g.get_edges(u)) {
-                if (!depth[i.to]) {
-                    depth[i.to] = depth[u] + 1;
-                    q.push(i.to);
-                }
-            }
+        static basic_mapped_graph<Weight, Index> map_binary(const string& path) {
+            return basic_mapped_graph<Weight, Index>(path);
         }
-        return depth;
-    }
+    };
 
-    graph introvert(graph tree) {
-        auto depth = get_depth(tree);
-        graph g(tree.N, true);
-        for (auto i : tree.get_edges()) {
-            int u = i.from, v = i.to;
-            auto w = i.weight;
-            if (depth[u] < depth[v]) std::swap(u, v);
-            g.add(u, v, w);
-        }
-        return g;
-    }
+    using graph = basic_graph<>;
 
-    graph externalize(graph tree) {
-        auto depth = get_depth(tree);
-        graph g(tree.N, true);
-        for (auto i : tree.get_edges()) {
-            int u = i.from, v = i.to;
-            auto w = i.weight;
-            if (depth[u] > depth[v]) std::swap(u, v);
-            g.add(u, v, w);
-        }
-        return g;
-    }
+    using edge = graph::edge;
 
-    graph lowhigh(int n, double low, double high, _Weight weightL = 0, _Weight weightR = 0) {
-        graph g(n, false);
-        for (int i = 2; i <= n; i++) {
-            int fa = randint(std::max((int)((i - 1) * low), 1), std::min((int)((i - 1) * high), i - 1));
-            g.add(fa, i, randint(weightL, weightR));
+    template <class Weight = _Weight, class Index = int>
+    class basic_graph_builder {
+    private:
+        Index N;
+        bool directed;
+        std::vector<basic_edge<Weight, Index>> edges;
+
+    public:
+        basic_graph_builder(Index N, bool directed = false) : N(N), directed(directed) {
+            err_positive_checker(N, __func__, "N");
         }
-        return g;
-    }
 
-    graph naive_tree(int n, _Weight weightL = 0, _Weight weightR = 0) {
-        return lowhigh(n, 0, 1, weightL, weightR);
-    }
+        void reserve(size_t m) { edges.reserve(m); }
 
-    graph tail(int n, int k, _Weight weightL = 0, _Weight weightR = 0) {
-        graph g(n, false);
-        for (int i = 2; i <= n; i++) {
-            int fa = randint(std::max(i - k, 1), i - 1);
-            g.add(fa, i, randint(weightL, weightR));
-        }
-        return g;
-    }
+        void add(const basic_edge<Weight, Index>& edg) { edges.push_back(edg); }
 
-    graph chain(int n, _Weight weightL = 0, _Weight weightR = 0) {
-        return tail(n, 1, weightL, weightR);
-    }
+        void add(Index from, Index to, Weight weight = Weight()) { edges.push_back(basic_edge<Weight, Index>(from, to, weight)); }
 
-    graph star(int n, _Weight weightL = 0, _Weight weightR = 0) {
-        graph g(n, false);
-        for (int i = 2; i <= n; i++) {
-            g.add(1, i, randint(weightL, weightR));
+        size_t size() const { return edges.size(); }
+
+        basic_graph<Weight, Index> build(bool enable_edge_map = false) {
+            basic_graph<Weight, Index> g(N, directed, enable_edge_map);
+            g.add_edges(std::move(edges));
+            edges = std::vector<basic_edge<Weight, Index>>();
+            return g;
         }
-        return g;
+    };
+
+    using graph_builder = basic_graph_builder<>;
+
+    template <class Weight>
+    Weight _weight_at(const Weight* weight, unsigned long long k) {
+        return weight[k];
     }
 
-    graph flower(int n, _Weight weightL = 0, _Weight weightR = 0) {
-        return star(n, weightL, weightR);
+    no_weight _weight_at(const no_weight*, unsigned long long) {
+        return no_weight();
     }
 
-    graph max_degree(int n, int k, _Weight weightL = 0, _Weight weightR = 0) {
-        graph g(n, false);
-        BalancedTree<std::pair<int, int>> tree;
-        tree.insert({1, 0});
-        for (int i = 2; i <= n; i++) {
-            auto fa = tree.kth(randint(1, tree.size()));
-            tree.erase(fa);
-            if (fa.second < k) tree.insert({fa.first, fa.second + 1});
-            g.add(fa.first, i, randint(weightL, weightR));
-            tree.insert({i, 0});
+    template <class Weight = _Weight, class Index = int>
+    struct basic_csr_view {
+        using weight_type = Weight;
+
+        using index_type = Index;
+
+        Index N;
+        const unsigned long long* offset;
+        const Index* adj;
+        const Weight* weight;
+
+        unsigned long long edge_count() const { return offset[N + 1]; }
+
+        unsigned long long degree(Index u) const { return offset[u + 1] - offset[u]; }
+
+        template <class Function>
+        void for_each_adjacent(Index u, Function function) const {
+            for (unsigned long long k = offset[u]; k < offset[u + 1]; k++) function(adj[k], _weight_at(weight, k));
         }
-        return g;
-    }
+    };
 
-    graph binary_tree(int n, _Weight weightL = 0, _Weight weightR = 0) {
-        return max_degree(n, 3, weightL, weightR);
-    }
+    template <class Weight = _Weight, class Index = int>
+    class basic_csr {
+    public:
+        Index N;
 
-    graph chain_star(int n, int k, _Weight weightL = 0, _Weight weightR = 0) {
-        graph g(n, false);
-        for (int i = 2; i <= k; i++) g.add(i - 1, i, randint(weightL, weightR));
-        for (int i = k + 1; i <= n; i++) g.add(randint(1, k), i, randint(weightL, weightR));
-        return g;
-    }
+        std::vector<unsigned long long> offset;
 
-    graph silkworm(int n, _Weight weightL = 0, _Weight weightR = 0) {
-        graph g(n, false);
-        for (int i = 2; i <= (n >> 1); i++) g.add(i - 1, i, randint(weightL, weightR));
-        for (int i = (n >> 1) + 1; i <= (n >> 1) << 1; i++) g.add(i - (n >> 1), i, randint(weightL, weightR));
-        if (((n >> 1) << 1) != n) g.add(randint(1, n - 1), n, randint(weightL, weightR));
-        return g;
-    }
+        std::vector<Index> adj;
 
-    graph firecrackers(int n, _Weight weightL = 0, _Weight weightR = 0) {
-        graph g(n, false);
-        int tmp = n / 3;
-        for (int i = 2; i <= tmp; i++) g.add(i - 1, i, randint(weightL, weightR));
-        for (int i = tmp + 1; i <= tmp * 2; i++) g.add(i - tmp, i, randint(weightL, weightR));
-        for (int i = (tmp << 1) + 1; i <= tmp * 3; i++) g.add(i - (tmp << 1), i, randint(weightL, weightR));
-        for (int i = (tmp * 3 + 1); i <= n; i++) g.add(randint(1, i - 1), i, randint(weightL, weightR));
-        return g;
-    }
+        std::vector<Weight> weight;
 
-    graph complete(int n, int k, _Weight weightL = 0, _Weight weightR = 0) {
-        graph g(n, false);
-        std::queue<int> q;
-        q.push(1);
-        int tot = 1;
-        while (!q.empty()) {
-            int u = q.front();
-            q.pop();
-            int bound = std::min(tot + k - 1, n);
-            for (int i = tot + 1; i <= bound; i++) {
-                g.add(u, (++tot), randint(weightL, weightR));
-                q.push(i);
+        basic_csr(const basic_graph<Weight, Index>& g) : N(g.N), offset(g.N + 2) {
+            for (Index u = 0; u <= N; u++) {
+                unsigned long long deg = 0;
+                g.for_each_adjacent(u, [&](Index, const Weight&) { deg++; });
+                offset[u + 1] = offset[u] + deg;
             }
+            adj.resize(offset[N + 1]);
+            if (!std::is_same<Weight, no_weight>::value) weight.resize(offset[N + 1]);
+            for (Index u = 0; u <= N; u++) {
+                unsigned long long k = offset[u];
+                g.for_each_adjacent(u, [&](Index v, const Weight& w) {
+                    if (!weight.empty()) weight[k] = w;
+                    adj[k++] = v;
+                });
+            }
+        }
+
+        basic_csr_view<Weight, Index> view() const {
+            return basic_csr_view<Weight, Index> {N, offset.data(), adj.data(), weight.data()};
+        }
+    };
+
+    using csr = basic_csr<>;
+
+    using csr_view = basic_csr_view<>;
+
+    template <class Weight = _Weight, class Index = int>
+    class basic_mapped_graph {
+    private:
+        void* data;
+        size_t length;
+        std::vector<unsigned long long> buffer;
+        const basic_edge<Weight, Index>* edge_data;
+        size_t edge_total;
+        basic_csr_view<Weight, Index> csr;
+
+        void _map(const string& path) {
+            FILE* file = fopen(path.c_str(), "rb");
+            if (file == nullptr) raise(carefree_file_exception("map_binary : cannot open file " + path));
+            _fseeki64(file, 0, SEEK_END);
+            length = _ftelli64(file);
+            _fseeki64(file, 0, SEEK_SET);
+            buffer.resize((length + 7) / 8);
+            size_t read = length ? fread(buffer.data(), 1, length, file) : 0;
+            fclose(file);
+            if (read != length) raise(carefree_file_exception("map_binary : failed to read file " + path));
+            data = buffer.data();
+        }
+
+        void _unmap() {
+            buffer = std::vector<unsigned long long>();
+            data = nullptr;
+        }
+
+    public:
+        Index N;
+
+        bool directed;
+
+        basic_mapped_graph(const string& path) : data(nullptr), length(0) {
+            _map(path);
+            const char* base = (const char*)data;
+            _binary_graph_header header;
+            if (length < sizeof(header)) {
+                _unmap();
+                raise(carefree_invalid_argument("map_binary : " + path + " is not a carefree binary graph."));
+            }
+            std::memcpy(&header, base, sizeof(header));
+            bool weighted = !std::is_same<Weight, no_weight>::value;
+            string error;
+            if (std::memcmp(header.magic, "CFGRAPH", 8))
+                error = "is not a carefree binary graph";
+            else if (header.byte_order != _binary_byte_order)
+                error = "was saved with a different byte order";
+            else if (header.version != _binary_graph_version)
+                error = "has unsupported version " + std::to_string(header.version);
+            else if (header.weight_size != (weighted ? sizeof(Weight) : 0) || header.index_size != sizeof(Index))
+                error = "was saved with different weight or index types";
+            size_t offset_at = sizeof(header), adj_at = offset_at;
+            bool sized = header.n < (unsigned long long)std::numeric_limits<Index>::max() && header.n + 2 > header.n && _binary_advance(adj_at, header.n + 2, sizeof(unsigned long long));
+            size_t weight_at = adj_at;
+            sized = sized && _binary_advance(weight_at, header.adj_count, sizeof(Index));
+            size_t edge_at = weight_at;
+            sized = sized && (!weighted || _binary_advance(edge_at, header.adj_count, sizeof(Weight)));
+            size_t end_at = edge_at;
+            sized = sized && _binary_advance(end_at, header.edge_count, sizeof(basic_edge<Weight, Index>));
+            if (error.empty() && !sized)
+                error = "is corrupt";
+            else if (error.empty() && end_at > length)
+                error = "is truncated";
+            if (error.empty()) {
+                const unsigned long long* offset = (const unsigned long long*)(base + offset_at);
+                if (offset[0] != 0 || offset[header.n + 1] != header.adj_count) error = "is corrupt";
+                for (unsigned long long u = 0; error.empty() && u <= header.n; u++)
+                    if (offset[u] > offset[u + 1]) error = "is corrupt";
+                const Index* adj = (const Index*)(base + adj_at);
+                for (unsigned long long k = 0; error.empty() && k < header.adj_count; k++)
+                    if (!_binary_vertex(adj[k], header.n)) error = "is corrupt";
+                const basic_edge<Weight, Index>* edge = (const basic_edge<Weight, Index>*)(base + edge_at);
+                for (unsigned long long k = 0; error.empty() && k < header.edge_count; k++)
+                    if (!_binary_vertex(edge[k].from, header.n) || !_binary_vertex(edge[k].to, header.n)) error = "is corrupt";
+            }
+            if (!error.empty()) {
+                _unmap();
+                raise(carefree_invalid_argument("map_binary : " + path + " " + error + "."));
+            }
+            N = header.n;
+            directed = header.flags & 1;
+            csr = basic_csr_view<Weight, Index> {N, (const unsigned long long*)(base + offset_at), (const Index*)(base + adj_at), weighted ? (const Weight*)(base + weight_at) : nullptr};
+            edge_data = (const basic_edge<Weight, Index>*)(base + edge_at);
+            edge_total = header.edge_count;
+        }
+
+        basic_mapped_graph(const basic_mapped_graph&) = delete;
+
+        basic_mapped_graph& operator=(const basic_mapped_graph&) = delete;
+
+        basic_mapped_graph(basic_mapped_graph&& other) : data(other.data), length(other.length), buffer(std::move(other.buffer)), edge_data(other.edge_data), edge_total(other.edge_total), csr(other.csr), N(other.N), directed(other.directed) {
+            other.data = nullptr;
+        }
+
+        ~basic_mapped_graph() { _unmap(); }
+
+        basic_csr_view<Weight, Index> view() const { return csr; }
+
+        size_t edge_count() const { return edge_total; }
+
+        const basic_edge<Weight, Index>* edges() const { return edge_data; }
+
+        basic_graph<Weight, Index> to_graph(bool enable_edge_map = false) const {
+            basic_graph<Weight, Index> g(N, directed, enable_edge_map);
+            g.add_edges(edge_data, edge_data + edge_total);
+            return g;
+        }
+    };
+
+    using mapped_graph = basic_mapped_graph<>;
+
+    using weighted_output = graph::weighted_output;
+
+    using unweighted_output = graph::unweighted_output;
+
+    namespace graph_format {
+        template <int base, class Index>
+        Index _label(Index u) {
+            return u - 1 + base;
+        }
+
+        template <class Writer, class Weight>
+        void _write_value(Writer& out, const Weight& weight) {
+            out.writeInteger(weight);
+        }
+
+        template <class Writer>
+        void _write_value(Writer&, const no_weight&) {}
+
+        template <class Writer>
+        void _write_value(Writer& out, const float& weight) {
+            out.writeFloat(weight);
+        }
+
+        template <class Writer>
+        void _write_value(Writer& out, const double& weight) {
+            out.writeFloat(weight);
+        }
+
+        template <class Writer>
+        void _write_value(Writer& out, const long double& weight) {
+            out.writeFloat(weight);
+        }
+
+        template <class Writer, class Weight>
+        void _write_weight(Writer& out, const Weight& weight) {
+            out.writeChar(' ');
+            _write_value(out, weight);
+        }
+
+        template <class Writer>
+        void _write_weight(Writer&, const no_weight&) {}
+
+        template <bool weighted, int base = 1>
+        struct edge_list {
+            template <class Writer, class Weight, class Index>
+            static void write_edge(Writer& out, const basic_edge<Weight, Index>& edg) {
+                out.writeInteger(_label<base>(edg.from));
+                out.writeChar(' ');
+                out.writeInteger(_label<base>(edg.to));
+                if (weighted) _write_weight(out, edg.weight);
+            }
+
+            template <class Writer, class Weight, class Index>
+            static void write(Writer& out, const basic_graph<Weight, Index>& g) {
+                const auto& edges = g.edges();
+                for (size_t i = 0; i < edges.size(); i++) {
+                    if (i) out.writeChar('\n');
+                    write_edge(out, edges[i]);
+                }
+            }
+        };
+
+        template <bool weighted, int base = 1>
+        struct parent_array {
+            template <class Writer, class Weight, class Index>
+            static void write(Writer& out, const basic_graph<Weight, Index>& g) {
+                if (g.edges().size() != (size_t)(g.N - 1)) raise(carefree_invalid_argument("graph_format::parent_array::write : graph is not a tree."));
+                std::vector<Index> fa(g.N + 1, Index(-1)), queue(1, 1);
+                std::vector<Weight> weight(weighted ? g.N + 1 : 0);
+                fa[1] = 0;
+                for (size_t i = 0; i < queue.size(); i++) {
+                    Index u = queue[i];
+                    g.for_each_adjacent(u, [&](Index v, const Weight& w) {
+                        if (v < 1 || v > g.N || ~fa[v]) return;
+                        fa[v] = u;
+                        if (weighted) weight[v] = w;
+                        queue.push_back(v);
+                    });
+                }
+                if (queue.size() != (size_t)g.N) raise(carefree_invalid_argument("graph_format::parent_array::write : graph is not a tree rooted at 1."));
+                for (Index i = 2; i <= g.N; i++) {
+                    if (i > 2) out.writeChar(' ');
+                    out.writeInteger(_label<base>(fa[i]));
+                }
+                if (weighted && !std::is_same<Weight, no_weight>::value) {
+                    out.writeChar('\n');
+                    for (Index i = 2; i <= g.N; i++) {
+                        if (i > 2) out.writeChar(' ');
+                        _write_value(out, weight[i]);
+                    }
+                }
+            }
+        };
+
+        template <bool weighted, int base = 1>
+        struct adjacency_list {
+            template <class Writer, class Weight, class Index>
+            static void write(Writer& out, const basic_graph<Weight, Index>& g) {
+                for (Index u = 1; u <= g.N; u++) {
+                    if (u > 1) out.writeChar('\n');
+                    size_t deg = 0;
+                    g.for_each_adjacent(u, [&](Index, const Weight&) { deg++; });
+                    out.writeInteger(deg);
+                    g.for_each_adjacent(u, [&](Index v, const Weight& w) {
+                        out.writeChar(' ');
+                        out.writeInteger(_label<base>(v));
+                        if (weighted) _write_weight(out, w);
+                    });
+                }
+            }
+        };
+
+        using weighted = edge_list<true>;
+
+        using unweighted = edge_list<false>;
+
+        using weighted_zero_indexed = edge_list<true, 0>;
+
+        using unweighted_zero_indexed = edge_list<false, 0>;
+
+        using parents = parent_array<false>;
+
+        using weighted_parents = parent_array<true>;
+
+        using adjacency = adjacency_list<false>;
+
+        using weighted_adjacency = adjacency_list<true>;
+    }  // namespace graph_format
+
+    template <class T>
+    using _uniform_distribution = typename std::conditional<std::is_floating_point<T>::value, std::uniform_real_distribution<T>, std::uniform_int_distribution<T>>::type;
+
+    namespace weights {
+        struct none {
+            using weight_type = no_weight;
+
+            no_weight operator()() const { return no_weight(); }
+
+            template <class Engine>
+            no_weight operator()(Engine&) const {
+                return no_weight();
+            }
+        };
+
+        template <class T = _Weight>
+        class uniform {
+        private:
+            T l, r;
+
+        public:
+            using weight_type = T;
+
+            uniform(T l = 0, T r = 0) : l(l), r(r) {
+                err_range_checker(l, r, "weights::uniform");
+            }
+
+            T operator()() const { return (*this)(public_random_engine); }
+
+            template <class Engine>
+            T operator()(Engine& engine) const {
+                return l == r ? l : _uniform_distribution<T>(l, r)(engine);
+            }
+        };
+
+        template <class T = _Weight>
+        class distinct {
+        private:
+            T l;
+            unsigned long long last;
+            bool exhausted;
+            std::unordered_map<unsigned long long, unsigned long long> swapped;
+
+        public:
+            using weight_type = T;
+
+            distinct(T l, T r) : l(l), last((unsigned long long)r - (unsigned long long)l), exhausted(false) {
+                err_range_checker(l, r, "weights::distinct");
+            }
+
+            T operator()() {
+                if (exhausted) raise(carefree_range_exception("weights::distinct : all weights in range have been used."));
+                unsigned long long j = std::uniform_int_distribution<unsigned long long>(0, last)(public_random_engine);
+                auto at = [&](unsigned long long x) {
+                    auto it = swapped.find(x);
+                    return it == swapped.end() ? x : it->second;
+                };
+                unsigned long long ret = at(j);
+                swapped[j] = at(last);
+                if (last)
+                    last--;
+                else
+                    exhausted = true;
+                return T(l + ret);
+            }
+        };
+
+        template <class Function>
+        class functor {
+        private:
+            Function function;
+
+        public:
+            using weight_type = typename std::decay<decltype(std::declval<Function&>()())>::type;
+
+            functor(Function function) : function(function) {}
+
+            weight_type operator()() { return function(); }
+        };
+
+        template <class Function>
+        functor<Function> custom(Function function) {
+            return functor<Function>(function);
+        }
+    }  // namespace weights
+
+    template <class Policy, class Result = void>
+    using _if_weight_policy = typename std::conditional<true, Result, typename Policy::weight_type>::type;
+
+    // parallel generators draw weights from per-block engines, so only stateless policies (none, uniform) qualify.
+    template <class Policy, class = void>
+    struct _is_engine_policy : std::false_type {};
+
+    template <class Policy>
+    struct _is_engine_policy<Policy, decltype((void)std::declval<const Policy&>()(std::declval<std::mt19937_64&>()))> : std::true_type {};
+
+    template <class Policy>
+    class _policy_ref {
+    private:
+        Policy* policy;
+
+    public:
+        using weight_type = typename Policy::weight_type;
+
+        _policy_ref(Policy& policy) : policy(&policy) {}
+
+        weight_type operator()() { return (*policy)(); }
+    };
+
+    class graph_validator {
+    private:
+        std::vector<long long> scratch;
+
+        long long* _buffer(size_t size, long long value) {
+            if (scratch.size() < size) scratch.resize(size);
+            std::fill(scratch.begin(), scratch.begin() + size, value);
+            return scratch.data();
+        }
+
+        static long long _find(long long* dsu, long long x) {
+            while (dsu[x] >= 0) {
+                if (dsu[dsu[x]] >= 0) dsu[x] = dsu[dsu[x]];
+                x = dsu[x];
+            }
+            return x;
+        }
+
+        static bool _unite(long long* dsu, long long x, long long y) {
+            x = _find(dsu, x), y = _find(dsu, y);
+            if (x == y) return false;
+            if (dsu[x] > dsu[y]) std::swap(x, y);
+            dsu[x] += dsu[y];
+            dsu[y] = x;
+            return true;
+        }
+
+        static long long _find(long long* dsu, long long* parity, long long x, long long& side) {
+            side = 0;
+            while (dsu[x] >= 0) {
+                long long y = dsu[x];
+                if (dsu[y] >= 0) {
+                    parity[x] ^= parity[y];
+                    dsu[x] = dsu[y];
+                }
+                side ^= parity[x];
+                x = dsu[x];
+            }
+            return x;
+        }
+
+        template <class Weight, class Index>
+        bool _forest(const basic_graph<Weight, Index>& g) {
+            long long* dsu = _buffer(g.N + 1, -1);
+            for (auto& i : g.edges()) {
+                if (!_unite(dsu, i.from, i.to)) return false;
+            }
+            return true;
+        }
+
+    public:
+        template <class Weight, class Index>
+        bool is_tree(const basic_graph<Weight, Index>& g) {
+            return g.edges().size() == (size_t)(g.N - 1) && _forest(g);
+        }
+
+        template <class Weight, class Index>
+        bool is_connected(const basic_graph<Weight, Index>& g) {
+            long long* dsu = _buffer(g.N + 1, -1);
+            long long components = g.N;
+            for (auto& i : g.edges()) {
+                if (i.from && i.to && _unite(dsu, i.from, i.to)) components--;
+            }
+            return components == 1;
+        }
+
+        template <class Weight, class Index>
+        bool is_acyclic(const basic_graph<Weight, Index>& g) {
+            if (!g.directed) return _forest(g);
+            long long* indeg = _buffer((g.N + 1) * 2, 0);
+            long long* queue = indeg + g.N + 1;
+            size_t head = 0, tail = 0;
+            for (auto& i : g.edges()) indeg[i.to]++;
+            for (Index u = 0; u <= g.N; u++) {
+                if (!indeg[u]) queue[tail++] = u;
+            }
+            while (head < tail) {
+                g.for_each_adjacent(queue[head++], [&](Index v, const Weight&) {
+                    if (!--indeg[v]) queue[tail++] = v;
+                });
+            }
+            return tail == (size_t)g.N + 1;
+        }
+
+        template <class Weight, class Index>
+        bool is_dag(const basic_graph<Weight, Index>& g) {
+            return g.directed && is_acyclic(g);
+        }
+
+        template <class Weight, class Index>
+        bool is_bipartite(const basic_graph<Weight, Index>& g) {
+            long long* dsu = _buffer((g.N + 1) * 2, -1);
+            long long* parity = dsu + g.N + 1;
+            std::fill(parity, parity + g.N + 1, 0);
+            for (auto& i : g.edges()) {
+                long long su, sv;
+                long long u = _find(dsu, parity, i.from, su), v = _find(dsu, parity, i.to, sv);
+                if (u == v) {
+                    if (su == sv) return false;
+                    continue;
+                }
+                if (dsu[u] > dsu[v]) std::swap(u, v);
+                dsu[u] += dsu[v];
+                dsu[v] = u;
+                parity[v] = su ^ sv ^ 1;
+            }
+            return true;
+        }
+
+        template <class Weight, class Index>
+        bool is_simple(const basic_graph<Weight, Index>& g) {
+            long long* stamp = _buffer(g.N + 1, -1);
+            for (Index u = 0; u <= g.N; u++) {
+                bool simple = true;
+                g.for_each_adjacent(u, [&](Index v, const Weight&) {
+                    if (v == u || stamp[v] == (long long)u) simple = false;
+                    stamp[v] = u;
+                });
+                if (!simple) return false;
+            }
+            return true;
+        }
+    };
+
+    template <class Weight, class Index>
+    bool is_tree(const basic_graph<Weight, Index>& g) {
+        return graph_validator().is_tree(g);
+    }
+
+    template <class Weight, class Index>
+    bool is_connected(const basic_graph<Weight, Index>& g) {
+        return graph_validator().is_connected(g);
+    }
+
+    template <class Weight, class Index>
+    bool is_acyclic(const basic_graph<Weight, Index>& g) {
+        return graph_validator().is_acyclic(g);
+    }
+
+    template <class Weight, class Index>
+    bool is_dag(const basic_graph<Weight, Index>& g) {
+        return graph_validator().is_dag(g);
+    }
+
+    template <class Weight, class Index>
+    bool is_bipartite(const basic_graph<Weight, Index>& g) {
+        return graph_validator().is_bipartite(g);
+    }
+
+    template <class Weight, class Index>
+    bool is_simple(const basic_graph<Weight, Index>& g) {
+        return graph_validator().is_simple(g);
+    }
+
+    template <class Weight, class Index>
+    basic_graph<Weight, Index> relabel(basic_graph<Weight, Index> g) {
+        std::vector<Index> perm;
+        for (Index i = 1; i <= g.N; i++) perm.push_back(i);
+        std::shuffle(perm.begin(), perm.end(), public_random_engine);
+        basic_graph<Weight, Index> new_(g.N, g.directed, g.enable_edge_map);
+        for (auto& i : g.edges()) {
+            new_.add(perm[i.from - 1], perm[i.to - 1], i.weight);
+        }
+        return new_;
+    }
+
+    template <class Weight, class Index, class Function>
+    void _append_mapped_edges(std::vector<basic_edge<Weight, Index>>& edges, const basic_graph<Weight, Index>& g, Function map) {
+        for (auto& i : g.edges()) edges.push_back(basic_edge<Weight, Index>(map(i.from), map(i.to), i.weight));
+    }
+
+    template <class Weight, class Index>
+    basic_graph<Weight, Index> _compose(Index n, const basic_graph<Weight, Index>& g, std::vector<basic_edge<Weight, Index>>&& edges) {
+        basic_graph<Weight, Index> ret(n, g.directed, g.enable_edge_map);
+        ret.add_edges(std::move(edges));
+        return ret;
+    }
+
+    template <class Weight, class Index>
+    basic_graph<Weight, Index> disjoint_union(basic_graph<Weight, Index> g1, const basic_graph<Weight, Index>& g2) {
+        if (g1.directed != g2.directed) raise(carefree_invalid_argument("disjoint_union : cannot combine directed and undirected graphs"));
+        Index offset = g1.N;
+        std::vector<basic_edge<Weight, Index>> edges = g1.release_edges();
+        edges.reserve(edges.size() + g2.edges().size());
+        _append_mapped_edges(edges, g2, [offset](Index u) { return u + offset; });
+        return _compose(Index(g1.N + g2.N), g1, std::move(edges));
+    }
+
+    template <class Weight, class Index>
+    basic_graph<Weight, Index> disjoint_union(std::vector<basic_graph<Weight, Index>> parts) {
+        if (parts.empty()) raise(carefree_invalid_argument("disjoint_union : parts must not be empty"));
+        size_t total = 0;
+        for (auto& g : parts) {
+            if (g.directed != parts[0].directed) raise(carefree_invalid_argument("disjoint_union : cannot combine directed and undirected graphs"));
+            total += g.edges().size();
+        }
+        std::vector<basic_edge<Weight, Index>> edges = parts[0].release_edges();
+        edges.reserve(total);
+        Index n = parts[0].N;
+        for (size_t i = 1; i < parts.size(); i++) {
+            Index offset = n;
+            _append_mapped_edges(edges, parts[i], [offset](Index u) { return u + offset; });
+            n += parts[i].N;
+        }
+        return _compose(n, parts[0], std::move(edges));
+    }
+
+    template <class Weight, class Index>
+    basic_graph<Weight, Index> attach(basic_graph<Weight, Index> g1, Index v, const basic_graph<Weight, Index>& g2, Index root = 1) {
+        if (g1.directed != g2.directed) raise(carefree_invalid_argument("attach : cannot combine directed and undirected graphs"));
+        err_inrange_checker(v, Index(1), g1.N, __func__, "v");
+        err_inrange_checker(root, Index(1), g2.N, __func__, "root");
+        Index offset = g1.N;
+        std::vector<basic_edge<Weight, Index>> edges = g1.release_edges();
+        edges.reserve(edges.size() + g2.edges().size());
+        _append_mapped_edges(edges, g2, [offset, v, root](Index u) { return u == root ? v : (u < root ? u + offset : u + offset - 1); });
+        return _compose(Index(g1.N + g2.N - 1), g1, std::move(edges));
+    }
+
+    template <class Weight, class Index>
+    basic_graph<Weight, Index> join_by_edges(basic_graph<Weight, Index> g1, const basic_graph<Weight, Index>& g2, const std::vector<basic_edge<Weight, Index>>& links) {
+        if (g1.directed != g2.directed) raise(carefree_invalid_argument("join_by_edges : cannot combine directed and undirected graphs"));
+        Index offset = g1.N;
+        for (auto& i : links) {
+            err_inrange_checker(i.from, Index(1), g1.N, __func__, "link.from");
+            err_inrange_checker(i.to, Index(1), g2.N, __func__, "link.to");
+        }
+        std::vector<basic_edge<Weight, Index>> edges = g1.release_edges();
+        edges.reserve(edges.size() + g2.edges().size() + links.size());
+        _append_mapped_edges(edges, g2, [offset](Index u) { return u + offset; });
+        for (auto& i : links) edges.push_back(basic_edge<Weight, Index>(i.from, i.to + offset, i.weight));
+        return _compose(Index(g1.N + g2.N), g1, std::move(edges));
+    }
+
+    template <class Weight, class Index>
+    class _graph_inserter {
+    private:
+        basic_graph<Weight, Index>* g;
+
+    public:
+        _graph_inserter(basic_graph<Weight, Index>& g) : g(&g) {}
+
+        void operator()(Index from, Index to, Weight weight) { g->add(from, to, weight); }
+    };
+
+    template <class Weight, class Index>
+    _graph_inserter<Weight, Index> graph_sink(basic_graph<Weight, Index>& g) {
+        return _graph_inserter<Weight, Index>(g);
+    }
+
+    template <class Sink>
+    class relabel_sink {
+    private:
+        std::vector<int> perm;
+        Sink sink;
+
+    public:
+        relabel_sink(int n, Sink sink) : perm(n), sink(sink) {
+            err_positive_checker(n, __func__, "n");
+            std::iota(perm.begin(), perm.end(), 1);
+            std::shuffle(perm.begin(), perm.end(), public_random_engine);
+        }
+
+        relabel_sink(std::vector<int> perm, Sink sink) : perm(std::move(perm)), sink(sink) {}
+
+        template <class Weight>
+        void operator()(int from, int to, const Weight& weight) { sink(perm[from - 1], perm[to - 1], weight); }
+    };
+
+    template <class Sink>
+    relabel_sink<typename std::decay<Sink>::type> relabeled(int n, Sink&& sink) {
+        return relabel_sink<typename std::decay<Sink>::type>(n, std::forward<Sink>(sink));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_prufer_decode(Sink&& sink, int n, const std::vector<int>& prufer, Policy weight) {
+        if (prufer.size() + 1 != (unsigned)(n - 1)) raise(carefree_invalid_argument("prufer_decode : prufer size must be n-1"));
+        std::vector<int> deg(n + 1, 1);
+        for (int i = 1; i <= (n - 2); i++) {
+            if (prufer[i - 1] < 1 || prufer[i - 1] > n) err_inrange_checker(prufer[i - 1], 1, n, __func__, "prufer[" + std::to_string(i) + "]");
+        }
+        for (int i = 1; i <= (n - 2); i++) deg[prufer[i - 1]]++;
+        int ptr = 1, leaf = 0;
+        while (deg[ptr] != 1) ptr++;
+        leaf = ptr;
+        for (int i = 1; i <= (n - 2); i++) {
+            int v = prufer[i - 1];
+            sink(v, leaf, weight());
+            if (--deg[v] == 1 && v < ptr)
+                leaf = v;
+            else {
+                ptr++;
+                while (deg[ptr] != 1) ptr++;
+                leaf = ptr;
+            }
+        }
+        sink(n, leaf, weight());
+    }
+
+    template <class Sink>
+    void stream_prufer_decode(Sink&& sink, int n, const std::vector<int>& prufer, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_prufer_decode(sink, n, prufer, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> prufer_decode(int n, const std::vector<int>& prufer, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_prufer_decode(graph_sink(g), n, prufer, weight);
+        return g;
+    }
+
+    graph prufer_decode(int n, std::vector<int> prufer, _Weight weightL = 0, _Weight weightR = 0) {
+        return prufer_decode(n, prufer, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Weight, class Index>
+    std::vector<int> get_depth(const basic_graph<Weight, Index>& g) {
+        std::queue<Index> q;
+        std::vector<int> depth(g.N + 1);
+        q.push(1);
+        depth[1] = 1;
+        while (!q.empty()) {
+            auto u = q.front();
+            q.pop();
+            g.for_each_adjacent(u, [&](Index v, const Weight&) {
+                if (!depth[v]) {
+                    depth[v] = depth[u] + 1;
+                    q.push(v);
+                }
+            });
+        }
+        return depth;
+    }
+
+    template <class Weight, class Index>
+    basic_graph<Weight, Index> introvert(const basic_graph<Weight, Index>& tree) {
+        auto depth = get_depth(tree);
+        basic_graph<Weight, Index> g(tree.N, true);
+        for (auto& i : tree.edges()) {
+            Index u = i.from, v = i.to;
+            if (depth[u] < depth[v]) std::swap(u, v);
+            g.add(u, v, i.weight);
         }
         return g;
     }
 
-    graph complete_binary(int n, _Weight weightL = 0, _Weight weightR = 0) {
-        return complete(n, 3, weightL, weightR);
-    }
+    template <class Weight, class Index>
+    basic_graph<Weight, Index> externalize(const basic_graph<Weight, Index>& tree) {
+        auto depth = get_depth(tree);
+        basic_graph<Weight, Index> g(tree.N, true);
+        for (auto& i : tree.edges()) {
+            Index u = i.from, v = i.to;
+            if (depth[u] > depth[v]) std::swap(u, v);
+            g.add(u, v, i.weight);
+        }
+        return g;
+    }
+
+    template <class Index = int>
+    class basic_tree_info {
+    public:
+        Index N, root;
+
+        std::vector<Index> parent, depth, size, heavy, order, tin, tout;
+
+        Index diameter_u, diameter_v, diameter, centroid;
+
+        template <class Weight>
+        basic_tree_info(const basic_csr_view<Weight, Index>& tree, Index root = 1) : N(tree.N), root(root), parent(N + 1), depth(N + 1), size(N + 1), heavy(N + 1), order(), tin(N + 1), tout(N + 1) {
+            err_inrange_checker(root, Index(1), N, __func__, "root");
+            order.reserve(N);
+            std::vector<Index> stack(1, root);
+            depth[root] = 1;
+            while (!stack.empty()) {
+                Index u = stack.back();
+                stack.pop_back();
+                tin[u] = (Index)order.size();
+                order.push_back(u);
+                tree.for_each_adjacent(u, [&](Index v, const Weight&) {
+                    if (v == parent[u] || v < 1 || v > N) return;
+                    if (depth[v]) raise(carefree_invalid_argument("tree_info : graph is not a tree."));
+                    parent[v] = u;
+                    depth[v] = depth[u] + 1;
+                    stack.push_back(v);
+                });
+            }
+            if (order.size() != (size_t)N) raise(carefree_invalid_argument("tree_info : graph is not connected."));
+            std::vector<Index> down(N + 1), far(N + 1);
+            std::iota(far.begin(), far.end(), Index(0));
+            diameter_u = diameter_v = root, diameter = 0;
+            for (size_t i = order.size(); i-- > 0;) {
+                Index u = order[i];
+                size[u]++;
+                tout[u] = tin[u] + size[u] - 1;
+                Index p = parent[u];
+                if (!p) continue;
+                size[p] += size[u];
+                if (!heavy[p] || size[u] > size[heavy[p]]) heavy[p] = u;
+                Index length = down[u] + 1;
+                if (down[p] + length > diameter) diameter = down[p] + length, diameter_u = far[p], diameter_v = far[u];
+                if (length > down[p]) down[p] = length, far[p] = far[u];
+            }
+            centroid = root;
+            for (Index u = 1; u <= N; u++) {
+                Index largest = N - size[u];
+                if (heavy[u]) largest = std::max(largest, size[heavy[u]]);
+                if (largest * 2 <= N) {
+                    centroid = u;
+                    break;
+                }
+            }
+        }
+
+        template <class Weight>
+        basic_tree_info(const basic_graph<Weight, Index>& tree, Index root = 1) : basic_tree_info(basic_csr<Weight, Index>(tree).view(), root) {}
+
+        bool is_ancestor(Index u, Index v) const { return tin[u] <= tin[v] && tout[v] <= tout[u]; }
+    };
+
+    using tree_info = basic_tree_info<>;
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_lowhigh(Sink&& sink, int n, double low, double high, Policy weight) {
+        for (int i = 2; i <= n; i++) {
+            int fa = randint(std::max((int)((i - 1) * low), 1), std::min((int)((i - 1) * high), i - 1));
+            sink(fa, i, weight());
+        }
+    }
+
+    template <class Sink>
+    void stream_lowhigh(Sink&& sink, int n, double low, double high, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_lowhigh(sink, n, low, high, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> lowhigh(int n, double low, double high, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_lowhigh(graph_sink(g), n, low, high, weight);
+        return g;
+    }
+
+    graph lowhigh(int n, double low, double high, _Weight weightL = 0, _Weight weightR = 0) {
+        return lowhigh(n, low, high, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_naive_tree(Sink&& sink, int n, Policy weight) {
+        stream_lowhigh(sink, n, 0, 1, weight);
+    }
+
+    template <class Sink>
+    void stream_naive_tree(Sink&& sink, int n, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_naive_tree(sink, n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> naive_tree(int n, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_naive_tree(graph_sink(g), n, weight);
+        return g;
+    }
+
+    graph naive_tree(int n, _Weight weightL = 0, _Weight weightR = 0) {
+        return naive_tree(n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_tail(Sink&& sink, int n, int k, Policy weight) {
+        for (int i = 2; i <= n; i++) {
+            int fa = randint(std::max(i - k, 1), i - 1);
+            sink(fa, i, weight());
+        }
+    }
+
+    template <class Sink>
+    void stream_tail(Sink&& sink, int n, int k, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_tail(sink, n, k, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> tail(int n, int k, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_tail(graph_sink(g), n, k, weight);
+        return g;
+    }
+
+    graph tail(int n, int k, _Weight weightL = 0, _Weight weightR = 0) {
+        return tail(n, k, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_chain(Sink&& sink, int n, Policy weight) {
+        stream_tail(sink, n, 1, weight);
+    }
+
+    template <class Sink>
+    void stream_chain(Sink&& sink, int n, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_chain(sink, n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> chain(int n, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_chain(graph_sink(g), n, weight);
+        return g;
+    }
+
+    graph chain(int n, _Weight weightL = 0, _Weight weightR = 0) {
+        return chain(n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_star(Sink&& sink, int n, Policy weight) {
+        for (int i = 2; i <= n; i++) {
+            sink(1, i, weight());
+        }
+    }
+
+    template <class Sink>
+    void stream_star(Sink&& sink, int n, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_star(sink, n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> star(int n, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_star(graph_sink(g), n, weight);
+        return g;
+    }
+
+    graph star(int n, _Weight weightL = 0, _Weight weightR = 0) {
+        return star(n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_flower(Sink&& sink, int n, Policy weight) {
+        stream_star(sink, n, weight);
+    }
+
+    template <class Sink>
+    void stream_flower(Sink&& sink, int n, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_flower(sink, n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> flower(int n, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_flower(graph_sink(g), n, weight);
+        return g;
+    }
+
+    graph flower(int n, _Weight weightL = 0, _Weight weightR = 0) {
+        return flower(n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_max_degree(Sink&& sink, int n, int k, Policy weight) {
+        std::vector<int> candidate(1, 1), used(std::max(n + 1, 2));
+        candidate.reserve(std::max(n, 1));
+        for (int i = 2; i <= n; i++) {
+            int pos = randint(0, (int)candidate.size() - 1), fa = candidate[pos];
+            if (++used[fa] > k) {
+                candidate[pos] = candidate.back();
+                candidate.pop_back();
+            }
+            sink(fa, i, weight());
+            candidate.push_back(i);
+        }
+    }
+
+    template <class Sink>
+    void stream_max_degree(Sink&& sink, int n, int k, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_max_degree(sink, n, k, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> max_degree(int n, int k, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_max_degree(graph_sink(g), n, k, weight);
+        return g;
+    }
+
+    graph max_degree(int n, int k, _Weight weightL = 0, _Weight weightR = 0) {
+        return max_degree(n, k, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_binary_tree(Sink&& sink, int n, Policy weight) {
+        stream_max_degree(sink, n, 3, weight);
+    }
+
+    template <class Sink>
+    void stream_binary_tree(Sink&& sink, int n, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_binary_tree(sink, n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> binary_tree(int n, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_binary_tree(graph_sink(g), n, weight);
+        return g;
+    }
+
+    graph binary_tree(int n, _Weight weightL = 0, _Weight weightR = 0) {
+        return binary_tree(n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_chain_star(Sink&& sink, int n, int k, Policy weight) {
+        for (int i = 2; i <= k; i++) sink(i - 1, i, weight());
+        for (int i = k + 1; i <= n; i++) sink(randint(1, k), i, weight());
+    }
+
+    template <class Sink>
+    void stream_chain_star(Sink&& sink, int n, int k, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_chain_star(sink, n, k, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> chain_star(int n, int k, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_chain_star(graph_sink(g), n, k, weight);
+        return g;
+    }
+
+    graph chain_star(int n, int k, _Weight weightL = 0, _Weight weightR = 0) {
+        return chain_star(n, k, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_silkworm(Sink&& sink, int n, Policy weight) {
+        for (int i = 2; i <= (n >> 1); i++) sink(i - 1, i, weight());
+        for (int i = (n >> 1) + 1; i <= (n >> 1) << 1; i++) sink(i - (n >> 1), i, weight());
+        if (((n >> 1) << 1) != n) sink(randint(1, n - 1), n, weight());
+    }
+
+    template <class Sink>
+    void stream_silkworm(Sink&& sink, int n, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_silkworm(sink, n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> silkworm(int n, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_silkworm(graph_sink(g), n, weight);
+        return g;
+    }
+
+    graph silkworm(int n, _Weight weightL = 0, _Weight weightR = 0) {
+        return silkworm(n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_firecrackers(Sink&& sink, int n, Policy weight) {
+        int tmp = n / 3;
+        for (int i = 2; i <= tmp; i++) sink(i - 1, i, weight());
+        for (int i = tmp + 1; i <= tmp * 2; i++) sink(i - tmp, i, weight());
+        for (int i = (tmp << 1) + 1; i <= tmp * 3; i++) sink(i - (tmp << 1), i, weight());
+        for (int i = (tmp * 3 + 1); i <= n; i++) sink(randint(1, i - 1), i, weight());
+    }
+
+    template <class Sink>
+    void stream_firecrackers(Sink&& sink, int n, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_firecrackers(sink, n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> firecrackers(int n, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_firecrackers(graph_sink(g), n, weight);
+        return g;
+    }
+
+    graph firecrackers(int n, _Weight weightL = 0, _Weight weightR = 0) {
+        return firecrackers(n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_complete(Sink&& sink, int n, int k, Policy weight) {
+        if (k < 2) return;
+        for (int i = 2; i <= n; i++) sink((i - 2) / (k - 1) + 1, i, weight());
+    }
+
+    template <class Sink>
+    void stream_complete(Sink&& sink, int n, int k, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_complete(sink, n, k, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> complete(int n, int k, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_complete(graph_sink(g), n, k, weight);
+        return g;
+    }
+
+    graph complete(int n, int k, _Weight weightL = 0, _Weight weightR = 0) {
+        return complete(n, k, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_complete_binary(Sink&& sink, int n, Policy weight) {
+        stream_complete(sink, n, 3, weight);
+    }
+
+    template <class Sink>
+    void stream_complete_binary(Sink&& sink, int n, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_complete_binary(sink, n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> complete_binary(int n, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_complete_binary(graph_sink(g), n, weight);
+        return g;
+    }
+
+    graph complete_binary(int n, _Weight weightL = 0, _Weight weightR = 0) {
+        return complete_binary(n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_random_tree(Sink&& sink, int n, Policy weight) {
+        std::vector<int> prufer;
+        prufer.reserve(std::max(n - 2, 0));
+        for (int i = 1; i <= n - 2; i++) prufer.push_back(randint(1, n));
+        stream_prufer_decode(sink, n, prufer, weight);
+    }
+
+    template <class Sink>
+    void stream_random_tree(Sink&& sink, int n, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_random_tree(sink, n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> random_tree(int n, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        g.reserve(std::max(n - 1, 0));
+        stream_random_tree(graph_sink(g), n, weight);
+        return g;
+    }
+
+    graph random_tree(int n, _Weight weightL = 0, _Weight weightR = 0) {
+        return random_tree(n, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    class _index_set {
+    private:
+        enum : unsigned long long { empty_slot = ~0ull };
+        std::vector<unsigned long long> table;
+        size_t mask, count;
+
+        static unsigned long long hash(unsigned long long x) {
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+            return x ^ (x >> 31);
+        }
+
+    public:
+        _index_set(size_t expected = 0) : count(0) {
+            size_t cap = 16;
+            while (cap < expected * 2) cap <<= 1;
+            table.assign(cap, empty_slot);
+            mask = cap - 1;
+        }
+
+        size_t size() const { return count; }
+
+        bool contains(unsigned long long x) const {
+            for (size_t i = hash(x) & mask;; i = (i + 1) & mask) {
+                if (table[i] == x) return true;
+                if (table[i] == empty_slot) return false;
+            }
+        }
+
+        bool insert(unsigned long long x) {
+            if ((count + 1) * 2 > table.size()) {
+                std::vector<unsigned long long> old(table.size() * 2, empty_slot);
+                old.swap(table);
+                mask = table.size() - 1;
+                count = 0;
+                for (auto i : old) {
+                    if (i != empty_slot) insert(i);
+                }
+            }
+            for (size_t i = hash(x) & mask;; i = (i + 1) & mask) {
+                if (table[i] == x) return false;
+                if (table[i] == empty_slot) {
+                    table[i] = x;
+                    count++;
+                    return true;
+                }
+            }
+        }
+    };
+
+    std::vector<unsigned long long> sample_distinct(unsigned long long size, unsigned long long k, const std::vector<unsigned long long>& excluded = {}) {
+        _index_set ex(excluded.size());
+        for (auto i : excluded) {
+            err_less_checker(i, size, __func__, "excluded value");
+            ex.insert(i);
+        }
+        unsigned long long space = size - ex.size();
+        err_leq_checker(k, space, __func__, "k");
+        std::vector<unsigned long long> low, high;
+        for (auto i : excluded) {
+            if (i < space) low.push_back(i);
+        }
+        std::sort(low.begin(), low.end());
+        low.erase(std::unique(low.begin(), low.end()), low.end());
+        for (unsigned long long i = space; i < size; i++) {
+            if (!ex.contains(i)) high.push_back(i);
+        }
+        auto actual = [&](unsigned long long v) {
+            if (low.empty() || !ex.contains(v)) return v;
+            return high[std::lower_bound(low.begin(), low.end(), v) - low.begin()];
+        };
+        bool dense = k > space / 2;
+        unsigned long long count = dense ? space - k : k;
+        _index_set chosen(count);
+        std::vector<unsigned long long> ret;
+        ret.reserve(k);
+        for (unsigned long long j = space - count; j < space; j++) {
+            unsigned long long t = std::uniform_int_distribution<unsigned long long>(0, j)(public_random_engine);
+            if (!chosen.insert(t)) chosen.insert(t = j);
+            if (!dense) ret.push_back(actual(t));
+        }
+        if (dense) {
+            for (unsigned long long i = 0; i < space; i++) {
+                if (!chosen.contains(i)) ret.push_back(actual(i));
+            }
+        }
+        std::shuffle(ret.begin(), ret.end(), public_random_engine);
+        return ret;
+    }
+
+    struct edge_space {
+        int n;
+        bool directed, self_loop;
+
+        edge_space(int n, bool directed, bool self_loop) : n(n), directed(directed), self_loop(self_loop) {}
+
+        static unsigned long long _tri(unsigned long long x) { return x * (x + 1) / 2; }
+
+        static unsigned long long _tri_root(unsigned long long x) {
+            unsigned long long r = (unsigned long long)((std::sqrt(8.0L * x + 1) - 1) / 2);
+            while (r && _tri(r) > x) r--;
+            while (_tri(r + 1) <= x) r++;
+            return r;
+        }
+
+        unsigned long long size() const {
+            unsigned long long N = n;
+            if (directed) return self_loop ? N * N : N * (N - 1);
+            return self_loop ? _tri(N) : _tri(N - 1);
+        }
+
+        unsigned long long encode(int u, int v) const {
+            unsigned long long a = u - 1, b = v - 1;
+            if (directed) return self_loop ? a * n + b : a * (n - 1) + (b < a ? b : b - 1);
+            if (a < b) std::swap(a, b);
+            return self_loop ? _tri(a) + b : _tri(a - 1) + b;
+        }
+
+        std::pair<int, int> decode(unsigned long long id) const {
+            unsigned long long a, b;
+            if (directed) {
+                unsigned long long width = self_loop ? n : n - 1;
+                a = id / width, b = id % width;
+                if (!self_loop && b >= a) b++;
+            } else if (self_loop) {
+                a = _tri_root(id), b = id - _tri(a);
+            } else {
+                a = _tri_root(id) + 1, b = id - _tri(a - 1);
+            }
+            return {(int)a + 1, (int)b + 1};
+        }
+    };
+
+    template <class Weight, class Index, class Policy>
+    void _add_random_edges(basic_graph<Weight, Index>& g, int count, bool repeat_edges, bool self_loop, Policy& weight) {
+        edge_space space(g.N, g.directed, self_loop);
+        if (repeat_edges) {
+            for (int i = 1; i <= count; i++) {
+                int u = randint(1, (int)g.N);
+                int v = self_loop ? randint(1, (int)g.N) : randint(1, (int)g.N - 1);
+                if (!self_loop && v >= u) v++;
+                g.add(u, v, weight());
+            }
+            return;
+        }
+        std::vector<unsigned long long> excluded;
+        excluded.reserve(g.edges().size());
+        for (auto& i : g.edges()) excluded.push_back(space.encode(i.from, i.to));
+        for (auto id : sample_distinct(space.size(), count, excluded)) {
+            auto e = space.decode(id);
+            if (!g.directed && randint(0, 1)) std::swap(e.first, e.second);
+            g.add(e.first, e.second, weight());
+        }
+    }
+
+    void _check_edge_count(const char* func_name, int n, int m, bool directed, bool repeat_edges, bool self_loop) {
+        err_natural_checker(m, func_name, "m");
+        if (!self_loop && n == 1 && m > 0) raise(carefree_invalid_argument(string(func_name) + " : cannot add edges to a single vertex without self loops."));
+        if (!repeat_edges) err_leq_checker((unsigned long long)m, edge_space(n, directed, self_loop).size(), func_name, "m");
+    }
+
+    std::vector<int> _random_composition(int total, int parts) {
+        std::vector<int> sizes;
+        auto cuts = sample_distinct(total - 1, parts - 1);
+        std::sort(cuts.begin(), cuts.end());
+        long long last = 0;
+        for (auto i : cuts) sizes.push_back(i + 1 - last), last = i + 1;
+        sizes.push_back(total - last);
+        return sizes;
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_dag(Sink&& sink, int n, int m, bool repeat_edges, bool connected, int longest, Policy weight) {
+        err_positive_checker(n, __func__, "n");
+        err_natural_checker(m, __func__, "m");
+        err_inrange_checker(longest, -1, n - 1, __func__, "longest");
+        if (connected && n > 1 && longest == 0) raise(carefree_invalid_argument("dag : a connected dag with more than one vertex has a path of length at least 1."));
+        std::vector<int> sizes;
+        if (longest < 0)
+            sizes.assign(n, 1);
+        else if (connected && n > 1) {
+            sizes = _random_composition(n - 1, longest);
+            sizes.insert(sizes.begin(), 1);
+        } else
+            sizes = _random_composition(n, longest + 1);
+        int layers = sizes.size();
+        std::vector<int> start(layers + 1), layer(n), order(n), chain;
+        std::vector<unsigned long long> total(layers + 1);
+        for (int l = 0; l < layers; l++) {
+            start[l + 1] = start[l] + sizes[l];
+            total[l + 1] = total[l] + (unsigned long long)sizes[l] * start[l];
+            std::fill(layer.begin() + start[l], layer.begin() + start[l + 1], l);
+            if (longest >= 0) chain.push_back(randint(start[l], start[l + 1] - 1));
+        }
+        std::iota(order.begin(), order.end(), 1);
+        std::shuffle(order.begin(), order.end(), public_random_engine);
+        auto encode = [&](int i, int j) { return total[layer[j]] + (unsigned long long)(j - start[layer[j]]) * start[layer[j]] + i; };
+        std::vector<unsigned long long> forced;
+        if (connected) {
+            forced.reserve(n - 1);
+            for (int j = start[1]; j < n; j++) {
+                int i = longest >= 0 && chain[layer[j]] == j ? chain[layer[j] - 1] : randint(0, start[layer[j]] - 1);
+                forced.push_back(encode(i, j));
+            }
+        } else if (longest > 0) {
+            for (int l = 1; l < layers; l++) forced.push_back(encode(chain[l - 1], chain[l]));
+        }
+        err_geq_checker((unsigned long long)m, (unsigned long long)forced.size(), __func__, "m");
+        if (!repeat_edges) err_leq_checker((unsigned long long)m, total[layers], __func__, "m");
+        auto emit = [&](unsigned long long id) {
+            int l = std::upper_bound(total.begin(), total.end(), id) - total.begin() - 1;
+            unsigned long long r = id - total[l];
+            sink(order[r % start[l]], order[start[l] + r / start[l]], weight());
+        };
+        for (auto id : forced) emit(id);
+        unsigned long long count = m - forced.size();
+        if (count && !total[layers]) raise(carefree_invalid_argument("dag : no vertex pair can take another edge."));
+        if (repeat_edges) {
+            for (unsigned long long i = 0; i < count; i++) emit(randint(0ull, total[layers] - 1));
+        } else {
+            for (auto id : sample_distinct(total[layers], count, forced)) emit(id);
+        }
+    }
+
+    template <class Sink>
+    void stream_dag(Sink&& sink, int n, int m, bool repeat_edges = false, bool connected = true, int longest = -1, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_dag(sink, n, m, repeat_edges, connected, longest, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> dag(int n, int m, bool repeat_edges, bool connected, int longest, Policy weight) {
+        using edge_type = basic_edge<typename Policy::weight_type, Index>;
+        std::vector<edge_type> edges;
+        edges.reserve(m);
+        stream_dag([&](int u, int v, const typename Policy::weight_type& w) { edges.push_back(edge_type(u, v, w)); }, n, m, repeat_edges, connected, longest, weight);
+        basic_graph<typename Policy::weight_type, Index> g(n, true);
+        g.add_edges(std::move(edges));
+        return g;
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> dag(int n, int m, bool repeat_edges, Policy weight) {
+        return dag<Index>(n, m, repeat_edges, true, -1, weight);
+    }
+
+    graph dag(int n, int m, bool repeat_edges = false, _Weight weightL = 0, _Weight weightR = 0) {
+        return dag(n, m, repeat_edges, true, -1, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> connected_undirected_graph(int n, int m, bool repeat_edges, bool self_loop, Policy weight) {
+        err_positive_checker(n, __func__, "n");
+        err_geq_checker(m, n - 1, __func__, "m");
+        _check_edge_count(__func__, n, m, false, repeat_edges, self_loop);
+        auto ret = random_tree<Index>(n, _policy_ref<Policy>(weight));
+        _add_random_edges(ret, m - (n - 1), repeat_edges, self_loop, weight);
+        return ret;
+    }
+
+    graph connected_undirected_graph(int n, int m, bool repeat_edges = false, bool self_loop = false, _Weight weightL = 0, _Weight weightR = 0) {
+        return connected_undirected_graph(n, m, repeat_edges, self_loop, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> connected_directed_graph(int n, int m, bool repeat_edges, bool self_loop, Policy weight) {
+        err_positive_checker(n, __func__, "n");
+        err_geq_checker(m, n - 1, __func__, "m");
+        _check_edge_count(__func__, n, m, true, repeat_edges, self_loop);
+        auto ret = externalize(random_tree<Index>(n, _policy_ref<Policy>(weight)));
+        _add_random_edges(ret, m - (n - 1), repeat_edges, self_loop, weight);
+        return ret;
+    }
+
+    graph connected_directed_graph(int n, int m, bool repeat_edges = false, bool self_loop = false, _Weight weightL = 0, _Weight weightR = 0) {
+        return connected_directed_graph(n, m, repeat_edges, self_loop, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> random_graph(int n, int m, bool directed, bool repeat_edges, bool self_loop, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> ret(n, directed);
+        _check_edge_count(__func__, n, m, directed, repeat_edges, self_loop);
+        _add_random_edges(ret, m, repeat_edges, self_loop, weight);
+        return ret;
+    }
+
+    graph random_graph(int n, int m, bool directed = true, bool repeat_edges = false, bool self_loop = false, _Weight weightL = 0, _Weight weightR = 0) {
+        return random_graph(n, m, directed, repeat_edges, self_loop, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    bool is_graphical(const std::vector<int>& degree) {
+        long long n = degree.size(), total = 0;
+        std::vector<long long> count(n + 1);
+        for (int d : degree) {
+            if (d < 0 || d >= n) return false;
+            count[d]++;
+            total += d;
+        }
+        if (total & 1) return false;
+        std::vector<long long> sorted, suffix(n + 1);
+        sorted.reserve(n);
+        for (long long d = n; d-- > 0;) sorted.insert(sorted.end(), count[d], d);
+        for (long long i = n; i-- > 0;) suffix[i] = suffix[i + 1] + sorted[i];
+        long long left = 0, p = n;
+        for (long long k = 1; k <= n; k++) {
+            left += sorted[k - 1];
+            while (p > 0 && sorted[p - 1] < k) p--;
+            long long q = std::max(p, k);
+            if (left > k * (k - 1) + k * (q - k) + suffix[q]) return false;
+        }
+        return true;
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_havel_hakimi(Sink&& sink, const std::vector<int>& degree, Policy weight) {
+        if (!is_graphical(degree)) raise(carefree_invalid_argument("havel_hakimi : degree sequence is not graphical."));
+        int n = degree.size(), top = 0;
+        for (int d : degree) top = std::max(top, d);
+        std::vector<int> order(n), rest(degree), at_least(top + 2), last(top + 1);
+        for (int d : degree) at_least[d]++;
+        for (int b = top; b >= 0; b--) at_least[b] += at_least[b + 1];
+        std::vector<int> fill(at_least.begin() + 1, at_least.end());
+        for (int v = 1; v <= n; v++) order[fill[degree[v - 1]]++] = v;
+        for (int b = 0; b <= top; b++) last[b] = at_least[b] - 1;
+        for (int h = 0; h < n; h++) {
+            int v = order[h];
+            for (int p = h + rest[v - 1]; p > h; p--) {
+                int u = order[p], b = rest[u - 1];
+                std::swap(order[p], order[last[b]--]);
+                rest[u - 1]--;
+                sink(v, u, weight());
+            }
+        }
+    }
+
+    template <class Sink>
+    void stream_havel_hakimi(Sink&& sink, const std::vector<int>& degree, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_havel_hakimi(sink, degree, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> havel_hakimi(const std::vector<int>& degree, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(degree.size(), false);
+        stream_havel_hakimi(graph_sink(g), degree, weight);
+        return g;
+    }
+
+    graph havel_hakimi(const std::vector<int>& degree, _Weight weightL = 0, _Weight weightR = 0) {
+        return havel_hakimi(degree, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    class _edge_counter {
+    private:
+        std::unordered_map<unsigned long long, int> count;
+
+        static unsigned long long key(int u, int v) {
+            if (u > v) std::swap(u, v);
+            return (unsigned long long)u << 32 | (unsigned)v;
+        }
+
+    public:
+        _edge_counter(const std::vector<std::pair<int, int>>& edges) {
+            count.reserve(edges.size() * 2);
+            for (auto& e : edges) count[key(e.first, e.second)]++;
+        }
+
+        int get(int u, int v) const {
+            auto it = count.find(key(u, v));
+            return it == count.end() ? 0 : it->second;
+        }
+
+        void add(int u, int v) { count[key(u, v)]++; }
+
+        void remove(int u, int v) {
+            auto it = count.find(key(u, v));
+            if (!--it->second) count.erase(it);
+        }
+
+        bool bad(const std::pair<int, int>& e) const { return e.first == e.second || get(e.first, e.second) > 1; }
+
+        bool swap(std::vector<std::pair<int, int>>& edges, size_t i, size_t j) {
+            int a = edges[i].first, b = edges[i].second, c = edges[j].first, d = edges[j].second;
+            if (randint(0, 1)) std::swap(c, d);
+            if (i == j || a == c || b == d || key(a, c) == key(b, d) || get(a, c) || get(b, d)) return false;
+            remove(a, b), remove(c, d), add(a, c), add(b, d);
+            edges[i] = {a, c}, edges[j] = {b, d};
+            return true;
+        }
+    };
+
+    void _rewire_simple(std::vector<std::pair<int, int>>& edges, const std::vector<int>& degree) {
+        _edge_counter counter(edges);
+        std::vector<size_t> queue;
+        for (size_t i = 0; i < edges.size(); i++) {
+            if (counter.bad(edges[i])) queue.push_back(i);
+        }
+        size_t budget = edges.size() * 16 + 1024;
+        while (!queue.empty() && budget) {
+            size_t i = queue.back();
+            if (!counter.bad(edges[i])) {
+                queue.pop_back();
+                continue;
+            }
+            budget--;
+            counter.swap(edges, i, randint<size_t>(0, edges.size() - 1));
+        }
+        if (queue.empty()) return;
+        edges.clear();
+        stream_havel_hakimi([&](int u, int v, no_weight) { edges.push_back({u, v}); }, degree, weights::none());
+        counter = _edge_counter(edges);
+        for (size_t t = edges.size() * 16; t > 0; t--) counter.swap(edges, randint<size_t>(0, edges.size() - 1), randint<size_t>(0, edges.size() - 1));
+    }
+
+    std::vector<std::pair<int, int>> _configuration_edges(const std::vector<int>& degree, bool simple) {
+        long long total = 0;
+        for (size_t i = 0; i < degree.size(); i++) {
+            if (degree[i] < 0) err_natural_checker(degree[i], "degree_sequence", "degree[" + std::to_string(i) + "]");
+            total += degree[i];
+        }
+        if (total & 1) raise(carefree_invalid_argument("degree_sequence : sum of degrees is odd."));
+        if (simple && !is_graphical(degree)) raise(carefree_invalid_argument("degree_sequence : degree sequence is not graphical."));
+        int n = degree.size();
+        std::vector<std::pair<int, int>> edges;
+        edges.reserve(total / 2);
+        if (simple && total / 2 > (long long)n * (n - 1) / 4) {
+            std::vector<int> complement(n), stamp(n + 1);
+            for (int i = 0; i < n; i++) complement[i] = n - 1 - degree[i];
+            std::vector<std::vector<int>> adj(n + 1);
+            for (auto& e : _configuration_edges(complement, true)) adj[e.first].push_back(e.second), adj[e.second].push_back(e.first);
+            for (int u = 1; u <= n; u++) {
+                for (int v : adj[u]) stamp[v] = u;
+                for (int v = u + 1; v <= n; v++) {
+                    if (stamp[v] != u) edges.push_back({u, v});
+                }
+            }
+            std::shuffle(edges.begin(), edges.end(), public_random_engine);
+            return edges;
+        }
+        std::vector<int> stub;
+        stub.reserve(total);
+        for (int i = 0; i < n; i++) stub.insert(stub.end(), degree[i], i + 1);
+        std::shuffle(stub.begin(), stub.end(), public_random_engine);
+        for (long long i = 0; i < total; i += 2) edges.push_back({stub[i], stub[i + 1]});
+        if (simple) _rewire_simple(edges, degree);
+        return edges;
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_degree_sequence(Sink&& sink, const std::vector<int>& degree, bool simple, Policy weight) {
+        for (auto& e : _configuration_edges(degree, simple)) sink(e.first, e.second, weight());
+    }
+
+    template <class Sink>
+    void stream_degree_sequence(Sink&& sink, const std::vector<int>& degree, bool simple = true, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_degree_sequence(sink, degree, simple, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> degree_sequence(const std::vector<int>& degree, bool simple, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(degree.size(), false);
+        stream_degree_sequence(graph_sink(g), degree, simple, weight);
+        return g;
+    }
+
+    graph degree_sequence(const std::vector<int>& degree, bool simple = true, _Weight weightL = 0, _Weight weightR = 0) {
+        return degree_sequence(degree, simple, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Sink, class Policy>
+    _if_weight_policy<Policy> stream_k_regular(Sink&& sink, int n, int k, Policy weight) {
+        err_positive_checker(n, __func__, "n");
+        err_inrange_checker(k, 0, n - 1, __func__, "k");
+        if ((long long)n * k % 2) raise(carefree_invalid_argument("k_regular : n * k must be even."));
+        stream_degree_sequence(sink, std::vector<int>(n, k), true, weight);
+    }
+
+    template <class Sink>
+    void stream_k_regular(Sink&& sink, int n, int k, _Weight weightL = 0, _Weight weightR = 0) {
+        stream_k_regular(sink, n, k, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> k_regular(int n, int k, Policy weight) {
+        basic_graph<typename Policy::weight_type, Index> g(n, false);
+        stream_k_regular(graph_sink(g), n, k, weight);
+        return g;
+    }
+
+    graph k_regular(int n, int k, _Weight weightL = 0, _Weight weightR = 0) {
+        return k_regular(n, k, weights::uniform<_Weight>(weightL, weightR));
+    }
+
+    unsigned default_threads() {
+        unsigned threads = std::thread::hardware_concurrency();
+        return threads ? threads : 1;
+    }
+
+    template <class Function>
+    void parallel_blocks(long long total, long long block_size, unsigned threads, Function function) {
+        long long blocks = (total + block_size - 1) / block_size;
+        if (threads == 0) threads = default_threads();
+        if ((long long)threads > blocks) threads = std::max(blocks, 1ll);
+        std::atomic<long long> next(0);
+        auto worker = [&]() {
+            for (long long b; (b = next++) < blocks;) function(b, b * block_size, std::min(total, (b + 1) * block_size));
+        };
+        std::vector<std::thread> pool;
+        for (unsigned i = 1; i < threads; i++) pool.emplace_back(worker);
+        worker();
+        for (auto& i : pool) i.join();
+    }
+
+    std::mt19937_64 block_engine(unsigned long long seed, unsigned long long block, unsigned stream = 0) {
+        std::seed_seq seq {(unsigned)seed, (unsigned)(seed >> 32), (unsigned)block, (unsigned)(block >> 32), stream};
+        return std::mt19937_64(seq);
+    }
+
+    const long long _parallel_block = 1 << 16;
+
+    template <class Weight, class Index>
+    basic_graph<Weight, Index> _graph_from_edges(int n, std::vector<basic_edge<Weight, Index>>&& edges) {
+        basic_graph<Weight, Index> g(n, false, false);
+        g.add_edges(std::move(edges));
+        return g;
+    }
+
+    template <class Index, class Policy, class Parent>
+    std::vector<basic_edge<typename Policy::weight_type, Index>> _parallel_parent_edges(int n, const Policy& weight, unsigned threads, Parent parent) {
+        static_assert(_is_engine_policy<Policy>::value, "parallel generators only accept weights::none and weights::uniform.");
+        using edge_type = basic_edge<typename Policy::weight_type, Index>;
+        err_positive_checker(n, "parallel_tree", "n");
+        unsigned long long seed = public_random_engine();
+        std::vector<edge_type> edges(n - 1, edge_type(0, 0));
+        parallel_blocks(n - 1, _parallel_block, threads, [&](long long block, long long l, long long r) {
+            auto engine = block_engine(seed, block);
+            for (long long j = l; j < r; j++) {
+                int i = j + 2;
+                int fa = parent(i, engine);
+                edges[j] = edge_type(fa, i, weight(engine));
+            }
+        });
+        return edges;
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> parallel_lowhigh(int n, double low, double high, Policy weight, unsigned threads = 0) {
+        for (int i = 2; i <= n; i++) {
+            int l = std::max((int)((i - 1) * low), 1), r = std::min((int)((i - 1) * high), i - 1);
+            if (l > r) {
+                err_range_checker(l, r, __func__);
+                return basic_graph<typename Policy::weight_type, Index>(n, false);
+            }
+        }
+        return _graph_from_edges(n, _parallel_parent_edges<Index>(n, weight, threads, [&](int i, std::mt19937_64& engine) {
+            return std::uniform_int_distribution<int>(std::max((int)((i - 1) * low), 1), std::min((int)((i - 1) * high), i - 1))(engine);
+        }));
+    }
+
+    graph parallel_lowhigh(int n, double low, double high, _Weight weightL = 0, _Weight weightR = 0, unsigned threads = 0) {
+        return parallel_lowhigh(n, low, high, weights::uniform<_Weight>(weightL, weightR), threads);
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> parallel_tail(int n, int k, Policy weight, unsigned threads = 0) {
+        err_positive_checker(k, __func__, "k");
+        return _graph_from_edges(n, _parallel_parent_edges<Index>(n, weight, threads, [&](int i, std::mt19937_64& engine) {
+            return std::uniform_int_distribution<int>(std::max(i - k, 1), i - 1)(engine);
+        }));
+    }
+
+    graph parallel_tail(int n, int k, _Weight weightL = 0, _Weight weightR = 0, unsigned threads = 0) {
+        return parallel_tail(n, k, weights::uniform<_Weight>(weightL, weightR), threads);
+    }
+
+    template <class Index = int, class Policy>
+    _if_weight_policy<Policy, basic_graph<typename Policy::weight_type, Index>> parallel_random_tree(int n, Policy weight, unsigned threads = 0) {
+        static_assert(_is_engine_policy<Policy>::value, "parallel generators only accept weights::none and weights::uniform.");
+        using edge_type = basic_edge<typename Policy::weight_type, Index>;
+        err_positive_checker(n, __func__, "n");
+        unsigned long long seed = public_random_engine();
+        std::vector<int> f(n + 1);
+        std::unique_ptr<std::atomic<int>[]> indeg(new std::atomic<int>[n + 1]);
+        parallel_blocks(n + 1, _parallel_block, threads, [&](long long, long long l, long long r) {
+            for (long long i = l; i < r; i++) indeg[i].store(0, std::memory_order_relaxed);
+        });
+        parallel_blocks(n, _parallel_block, threads, [&](long long block, long long l, long long r) {
+            auto engine = block_engine(seed, block);
+            std::uniform_int_distribution<int> value(1, n);
+            for (long long i = l + 1; i <= r; i++) {
+                f[i] = value(engine);
+                indeg[f[i]].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        std::vector<char> cyclic(n + 1, 1), leaf(n + 1);
+        parallel_blocks(n, _parallel_block, threads, [&](long long, long long l, long long r) {
+            for (long long i = l + 1; i <= r; i++) leaf[i] = indeg[i].load(std::memory_order_relaxed) == 0;
+        });
+        parallel_blocks(n, _parallel_block, threads, [&](long long, long long l, long long r) {
+            for (long long i = l + 1; i <= r; i++) {
+                if (!leaf[i]) continue;
+                for (int x = i;;) {
+                    cyclic[x] = 0;
+                    x = f[x];
+                    if (indeg[x].fetch_sub(1, std::memory_order_acq_rel) != 1) break;
+                }
+            }
+        });
+        long long blocks = (n + _parallel_block - 1) / _parallel_block;
+        std::vector<long long> offset(blocks + 1);
+        parallel_blocks(n, _parallel_block, threads, [&](long long block, long long l, long long r) {
+            for (long long i = l + 1; i <= r; i++) offset[block + 1] += !cyclic[i];
+        });
+        for (long long i = 0; i < blocks; i++) offset[i + 1] += offset[i];
+        std::vector<edge_type> edges(n - 1, edge_type(0, 0));
+        parallel_blocks(n, _parallel_block, threads, [&](long long block, long long l, long long r) {
+            auto engine = block_engine(seed, block, 1);
+            long long pos = offset[block];
+            for (long long i = l + 1; i <= r; i++) {
+                if (!cyclic[i]) edges[pos++] = edge_type(i, f[i], weight(engine));
+            }
+        });
+        auto engine = block_engine(seed, blocks, 1);
+        long long pos = offset[blocks];
+        int last = 0;
+        for (int i = 1; i <= n; i++) {
+            if (!cyclic[i]) continue;
+            if (last) edges[pos++] = edge_type(f[last], f[i], weight(engine));
+            last = i;
+        }
+        return _graph_from_edges(n, std::move(edges));
+    }
+
+    graph parallel_random_tree(int n, _Weight weightL = 0, _Weight weightR = 0, unsigned threads = 0) {
+        return parallel_random_tree(n, weights::uniform<_Weight>(weightL, weightR), threads);
+    }
+
+    template <class T, class Compare = std::less<T>>
+    void parallel_sort(std::vector<T>& val, unsigned threads = 0, Compare compare = Compare()) {
+        if (threads == 0) threads = default_threads();
+        long long n = val.size(), block = std::max((n + threads - 1) / threads, _parallel_block);
+        parallel_blocks(n, block, threads, [&](long long, long long l, long long r) {
+            std::sort(val.begin() + l, val.begin() + r, compare);
+        });
+        for (long long width = block; width < n; width *= 2) {
+            parallel_blocks(n, width * 2, threads, [&](long long, long long l, long long r) {
+                if (l + width < r) std::inplace_merge(val.begin() + l, val.begin() + l + width, val.begin() + r, compare);
+            });
+        }
+    }
+
+    template <class T>
+    void parallel_shuffle(std::vector<T>& val, unsigned threads = 0) {
+        long long n = val.size();
+        unsigned long long seed = public_random_engine();
+        if (n < 2) return;
+        long long blocks = (n + _parallel_block - 1) / _parallel_block, buckets = std::min(blocks, 1024ll);
+        std::vector<unsigned short> bucket(n);
+        std::vector<long long> count(blocks * buckets);
+        parallel_blocks(n, _parallel_block, threads, [&](long long block, long long l, long long r) {
+            auto engine = block_engine(seed, block);
+            std::uniform_int_distribution<int> pick(0, buckets - 1);
+            for (long long i = l; i < r; i++) count[block * buckets + (bucket[i] = pick(engine))]++;
+        });
+        long long sum = 0;
+        std::vector<long long> begin(buckets + 1);
+        for (long long k = 0; k < buckets; k++) {
+            begin[k] = sum;
+            for (long long b = 0; b < blocks; b++) {
+                long long c = count[b * buckets + k];
+                count[b * buckets + k] = sum;
+                sum += c;
+            }
+        }
+        begin[buckets] = sum;
+        std::vector<T> result(n, val.front());
+        parallel_blocks(n, _parallel_block, threads, [&](long long block, long long l, long long r) {
+            long long* pos = count.data() + block * buckets;
+            for (long long i = l; i < r; i++) result[pos[bucket[i]]++] = val[i];
+        });
+        parallel_blocks(buckets, 1, threads, [&](long long k, long long, long long) {
+            auto engine = block_engine(seed, k, 1);
+            std::shuffle(result.begin() + begin[k], result.begin() + begin[k + 1], engine);
+        });
+        val.swap(result);
+    }
+
+    template <class Weight, class Index>
+    void parallel_relabel(basic_graph<Weight, Index>& g, unsigned threads = 0) {
+        std::vector<Index> perm(g.N);
+        std::iota(perm.begin(), perm.end(), Index(1));
+        parallel_shuffle(perm, threads);
+        g.modify_edges([&](std::vector<basic_edge<Weight, Index>>& edges) {
+            parallel_blocks(edges.size(), _parallel_block, threads, [&](long long, long long l, long long r) {
+                for (long long i = l; i < r; i++) {
+                    if (edges[i].from > 0) edges[i].from = perm[edges[i].from - 1];
+                    if (edges[i].to > 0) edges[i].to = perm[edges[i].to - 1];
+                }
+            });
+        });
+    }
+
+    template <class Weight, class Index>
+    void parallel_shuffle_edges(basic_graph<Weight, Index>& g, bool swap_endpoints = true, unsigned threads = 0) {
+        g.modify_edges([&](std::vector<basic_edge<Weight, Index>>& edges) {
+            parallel_shuffle(edges, threads);
+            if (g.directed || !swap_endpoints) return;
+            unsigned long long seed = public_random_engine();
+            parallel_blocks(edges.size(), _parallel_block, threads, [&](long long block, long long l, long long r) {
+                auto engine = block_engine(seed, block);
+                for (long long i = l; i < r; i += 64) {
+                    unsigned long long bits = engine();
+                    for (long long j = i; j < std::min(r, i + 64); j++, bits >>= 1) {
+                        if (bits & 1) std::swap(edges[j].from, edges[j].to);
+                    }
+                }
+            });
+        });
+    }
+
+    template <class Value>
+    class _radix_heap {
+    private:
+        std::vector<std::pair<unsigned long long, Value>> bucket[65];
+        unsigned long long last;
+        size_t count;
+
+        static int _bucket(unsigned long long x) { return x ? 64 - __builtin_clzll(x) : 0; }
+
+    public:
+        using key_type = unsigned long long;
+
+        _radix_heap() : last(0), count(0) {}
+
+        bool empty() const { return !count; }
+
+        void push(unsigned long long key, Value value) {
+            count++;
+            bucket[_bucket(key ^ last)].push_back({key, value});
+        }
+
+        std::pair<unsigned long long, Value> pop() {
+            if (bucket[0].empty()) {
+                int i = 1;
+                while (bucket[i].empty()) i++;
+                last = bucket[i][0].first;
+                for (auto& x : bucket[i]) last = std::min(last, x.first);
+                for (auto& x : bucket[i]) bucket[_bucket(x.first ^ last)].push_back(x);
+                bucket[i].clear();
+            }
+            count--;
+            auto ret = bucket[0].back();
+            bucket[0].pop_back();
+            return ret;
+        }
+    };
+
+    template <class Key, class Value>
+    class _binary_heap {
+    private:
+        std::priority_queue<std::pair<Key, Value>, std::vector<std::pair<Key, Value>>, std::greater<std::pair<Key, Value>>> heap;
+
+    public:
+        using key_type = Key;
+
+        bool empty() const { return heap.empty(); }
+
+        void push(Key key, Value value) { heap.push({key, value}); }
+
+        std::pair<Key, Value> pop() {
+            auto ret = heap.top();
+            heap.pop();
+            return ret;
+        }
+    };
+
+    // the radix heap needs keys that convert exactly to unsigned long long; other weights fall back to a binary heap.
+    template <class Weight, class Index>
+    using _dijkstra_heap = typename std::conditional<std::is_integral<Weight>::value && sizeof(Weight) <= sizeof(unsigned long long), _radix_heap<Index>, _binary_heap<Weight, Index>>::type;
+
+    template <class Weight, class Index>
+    std::vector<Weight> dijkstra(const basic_csr_view<Weight, Index>& g, typename basic_csr_view<Weight, Index>::index_type source) {
+        err_inrange_checker(source, Index(0), g.N, __func__, "source");
+        std::vector<Weight> dist(g.N + 1, Weight(-1));
+        _dijkstra_heap<Weight, Index> heap;
+        dist[source] = 0;
+        heap.push(0, source);
+        while (!heap.empty()) {
+            auto top = heap.pop();
+            Index u = top.second;
+            if (top.first != (typename _dijkstra_heap<Weight, Index>::key_type)dist[u]) continue;
+            g.for_each_adjacent(u, [&](Index v, const Weight& w) {
+                if (!(w >= 0)) raise(carefree_invalid_argument("dijkstra : negative or NaN edge weight."));
+                if (dist[v] == Weight(-1) || dist[u] + w < dist[v]) {
+                    dist[v] = dist[u] + w;
+                    heap.push(dist[v], v);
+                }
+            });
+        }
+        return dist;
+    }
+
+    template <class Weight, class Index>
+    std::vector<Weight> bfs01(const basic_csr_view<Weight, Index>& g, typename basic_csr_view<Weight, Index>::index_type source) {
+        err_inrange_checker(source, Index(0), g.N, __func__, "source");
+        std::vector<Weight> dist(g.N + 1, Weight(-1));
+        std::deque<Index> queue(1, source);
+        std::vector<char> done(g.N + 1);
+        dist[source] = 0;
+        while (!queue.empty()) {
+            Index u = queue.front();
+            queue.pop_front();
+            if (done[u]) continue;
+            done[u] = 1;
+            g.for_each_adjacent(u, [&](Index v, const Weight& w) {
+                if (w != 0 && w != 1) raise(carefree_invalid_argument("bfs01 : edge weight is neither 0 nor 1."));
+                if (dist[v] == Weight(-1) || dist[u] + w < dist[v]) {
+                    dist[v] = dist[u] + w;
+                    if (w)
+                        queue.push_back(v);
+                    else
+                        queue.push_front(v);
+                }
+            });
+        }
+        return dist;
+    }
+
+    template <class Weight, class Index>
+    std::vector<basic_edge<Weight, Index>> kruskal(const basic_graph<Weight, Index>& g, unsigned threads = 0) {
+        const auto& edges = g.edges();
+        std::vector<size_t> order(edges.size());
+        std::iota(order.begin(), order.end(), 0);
+        parallel_sort(order, threads, [&](size_t a, size_t b) { return edges[a].weight < edges[b].weight || (!(edges[b].weight < edges[a].weight) && a < b); });
+        std::vector<long long> dsu(g.N + 1, -1);
+        auto find = [&](long long x) {
+            while (dsu[x] >= 0) {
+                if (dsu[dsu[x]] >= 0) dsu[x] = dsu[dsu[x]];
+                x = dsu[x];
+            }
+            return x;
+        };
+        std::vector<basic_edge<Weight, Index>> ret;
+        for (size_t i : order) {
+            long long u = find(edges[i].from), v = find(edges[i].to);
+            if (u == v) continue;
+            if (dsu[u] > dsu[v]) std::swap(u, v);
+            dsu[u] += dsu[v];
+            dsu[v] = u;
+            ret.push_back(edges[i]);
+        }
+        return ret;
+    }
+
+    template <class Weight, class Index>
+    std::vector<basic_edge<Weight, Index>> prim(const basic_csr_view<Weight, Index>& g) {
+        using item = std::pair<Weight, std::pair<Index, Index>>;
+        std::priority_queue<item, std::vector<item>, std::greater<item>> heap;
+        std::vector<char> done(g.N + 1);
+        std::vector<basic_edge<Weight, Index>> ret;
+        for (Index s = 1; s <= g.N; s++) {
+            if (done[s]) continue;
+            heap.push(item(Weight(), {0, s}));
+            while (!heap.empty()) {
+                item top = heap.top();
+                heap.pop();
+                Index u = top.second.second;
+                if (done[u]) continue;
+                done[u] = 1;
+                if (top.second.first) ret.push_back(basic_edge<Weight, Index>(top.second.first, u, top.first));
+                g.for_each_adjacent(u, [&](Index v, const Weight& w) {
+                    if (!done[v]) heap.push(item(w, {u, v}));
+                });
+            }
+        }
+        return ret;
+    }
+
+    template <class Weight, class Index>
+    std::vector<Index> scc(const basic_csr_view<Weight, Index>& g) {
+        std::vector<Index> comp(g.N + 1), low(g.N + 1), dfn(g.N + 1), stack;
+        std::vector<std::pair<Index, unsigned long long>> call;
+        Index timer = 0, count = 0;
+        for (Index s = 1; s <= g.N; s++) {
+            if (dfn[s]) continue;
+            call.push_back({s, g.offset[s]});
+            dfn[s] = low[s] = ++timer;
+            stack.push_back(s);
+            while (!call.empty()) {
+                Index u = call.back().first;
+                unsigned long long& k = call.back().second;
+                if (k < g.offset[u + 1]) {
+                    Index v = g.adj[k++];
+                    if (v < 1 || v > g.N) continue;
+                    if (!dfn[v]) {
+                        dfn[v] = low[v] = ++timer;
+                        stack.push_back(v);
+                        call.push_back({v, g.offset[v]});
+                    } else if (!comp[v])
+                        low[u] = std::min(low[u], dfn[v]);
+                    continue;
+                }
+                call.pop_back();
+                if (!call.empty()) low[call.back().first] = std::min(low[call.back().first], low[u]);
+                if (low[u] != dfn[u]) continue;
+                count++;
+                Index v;
+                do {
+                    v = stack.back();
+                    stack.pop_back();
+                    comp[v] = count;
+                } while (v != u);
+            }
+        }
+        for (Index u = 1; u <= g.N; u++) comp[u] = count + 1 - comp[u];
+        return comp;
+    }
+
+    template <class Weight, class Index>
+    std::vector<Weight> dijkstra(const basic_graph<Weight, Index>& g, typename basic_csr_view<Weight, Index>::index_type source) {
+        basic_csr<Weight, Index> csr(g);
+        return dijkstra(csr.view(), source);
+    }
+
+    template <class Weight, class Index>
+    std::vector<Weight> bfs01(const basic_graph<Weight, Index>& g, typename basic_csr_view<Weight, Index>::index_type source) {
+        basic_csr<Weight, Index> csr(g);
+        return bfs01(csr.view(), source);
+    }
+
+    template <class Weight, class Index>
+    std::vector<basic_edge<Weight, Index>> prim(const basic_graph<Weight, Index>& g) {
+        basic_csr<Weight, Index> csr(g);
+        return prim(csr.view());
+    }
+
+    template <class Weight, class Index>
+    std::vector<Index> scc(const basic_graph<Weight, Index>& g) {
+        basic_csr<Weight, Index> csr(g);
+        return scc(csr.view());
+    }
+
+    bool _preallocate(int fd, unsigned long long size) {
+        return _chsize_s(fd, size) == 0;
+    }
+
+    unsigned long long _file_size(const string& path) {
+        struct stat info;
+        return stat(path.c_str(), &info) ? 0 : info.st_size;
+    }
+
+    int _pipe_write(int fd, const char* data, size_t size) {
+        while (size) {
+            auto written = ::write(fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return errno;
+            }
+            data += written;
+            size -= written;
+        }
+        return 0;
+    }
+
+    class _std_process {
+    private:
+        FILE* pipe;
+        string command;
+
+    public:
+        _std_process() : pipe(nullptr) {}
+        _std_process(const _std_process&) = delete;
+        _std_process& operator=(const _std_process&) = delete;
+        ~_std_process() { wait(); }
+
+        void start(const string& command, const string& input, const string& output) {
+            if (!input.empty()) {
+                this->command = command + " < \"" + input + "\" > \"" + output + "\"";
+                return;
+            }
+            pipe = _popen((command + " > \"" + output + "\"").c_str(), "w");
+            if (pipe == nullptr) raise(carefree_system_exception("testcase_writer::output_gen : cannot start program " + command));
+        }
+
+        int input() const { return pipe == nullptr ? -1 : _fileno(pipe); }
+
+        int wait() {
+            if (pipe != nullptr) {
+                int returnid = _pclose(pipe);
+                pipe = nullptr;
+                return returnid;
+            }
+            if (command.empty()) return 0;
+            int returnid = std::system(command.c_str());
+            command.clear();
+            return returnid;
+        }
+    };
+
+    constexpr size_t _format_length(const char* format) {
+        size_t length = 0;
+        while (format[length] != '\0') length++;
+        return length;
+    }
+
+    template <size_t Length>
+    struct _format_layout {
+        char text[Length + 1];
+        size_t begin[Length + 2], end[Length + 2];
+        size_t placeholders;
+        bool valid;
+    };
+
+    template <size_t Length>
+    constexpr _format_layout<Length> _parse_format(const char* format) {
+        _format_layout<Length> layout{};
+        size_t length = 0, count = 0;
+        layout.valid = true;
+        for (size_t i = 0; i < Length; i++) {
+            char next = i + 1 < Length ? format[i + 1] : '\0';
+            if ((format[i] == '{' || format[i] == '}') && next == format[i]) {
+                layout.text[length++] = format[i++];
+            } else if (format[i] == '{' && next == '}') {
+                layout.end[count] = length;
+                layout.begin[++count] = length;
+                i++;
+            } else if (format[i] == '{' || format[i] == '}') {
+                layout.valid = false;
+            } else
+                layout.text[length++] = format[i];
+        }
+        layout.end[count] = length;
+        layout.placeholders = count;
+        return layout;
+    }
+
+    template <class Format>
+    struct _format_traits {
+        static constexpr size_t length = _format_length(Format::value());
+        static constexpr _format_layout<length> layout = _parse_format<length>(Format::value());
+    };
+
+    template <class Format>
+    constexpr size_t _format_traits<Format>::length;
+
+    template <class Format>
+    constexpr _format_layout<_format_traits<Format>::length> _format_traits<Format>::layout;
+
+#if __cplusplus >= 202002L
+    template <size_t N>
+    struct _fixed_format_string {
+        char data[N];
+
+        constexpr _fixed_format_string(const char (&str)[N]) {
+            for (size_t i = 0; i < N; i++) data[i] = str[i];
+        }
+    };
+
+    template <_fixed_format_string String>
+    struct _fixed_format {
+        static constexpr const char* value() { return String.data; }
+    };
+#endif
+
+#define CAREFREE_FORMAT(str)                                           \
+    [] {                                                               \
+        struct _carefree_format {                                      \
+            static constexpr const char* value() { return str; }       \
+        };                                                             \
+        return _carefree_format();                                     \
+    }()
+
+#define CAREFREE_INPUTF(io, str, ...) (io).inputf(CAREFREE_FORMAT(str), ##__VA_ARGS__)
+
+#define CAREFREE_OUTPUTF(io, str, ...) (io).outputf(CAREFREE_FORMAT(str), ##__VA_ARGS__)
+
+    string _read_file(const string& path, const char* func_name) {
+        string content;
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            raise(carefree_file_exception(join_str(func_name, " : cannot open file ") + path));
+            return content;
+        }
+        char block[1 << 16];
+        size_t length;
+        while ((length = std::fread(block, 1, sizeof(block), file)) != 0) content.append(block, length);
+        std::fclose(file);
+        return content;
+    }
+
+    class shared_solution {
+    private:
+        using solve_type = int (*)(FILE*, FILE*);
+        HMODULE handle;
+        solve_type entry;
+
+    public:
+        shared_solution(const string& path, const string& symbol = "solve") : handle(nullptr), entry(nullptr) {
+            handle = LoadLibraryA(path.c_str());
+            if (handle == nullptr) {
+                raise(carefree_file_exception("shared_solution::shared_solution : cannot load " + path));
+                return;
+            }
+            entry = reinterpret_cast<solve_type>(GetProcAddress(handle, symbol.c_str()));
+            if (entry == nullptr) raise(carefree_invalid_argument("shared_solution::shared_solution : symbol " + symbol + " is not found in " + path));
+        }
+
+        shared_solution(const shared_solution&) = delete;
+        shared_solution& operator=(const shared_solution&) = delete;
+
+        ~shared_solution() {
+            if (handle != nullptr) FreeLibrary(handle);
+        }
+
+        int run(const string& input, string& output, bool isolate = false) {
+            if (entry == nullptr) {
+                raise(carefree_unsupported_operation("shared_solution::run : solution is not loaded."));
+                return -1;
+            }
+            if (isolate) {
+                raise(carefree_unsupported_operation("shared_solution::run : isolated runs are not supported on Windows."));
+                return -1;
+            }
+            FILE* in = std::tmpfile();
+            FILE* out = std::tmpfile();
+            if (in == nullptr || out == nullptr) {
+                if (in != nullptr) std::fclose(in);
+                if (out != nullptr) std::fclose(out);
+                raise(carefree_system_exception("shared_solution::run : cannot create temporary streams"));
+                return -1;
+            }
+            std::fwrite(input.data(), 1, input.size(), in);
+            std::rewind(in);
+            int returnid = entry(in, out);
+            std::rewind(out);
+            output.clear();
+            char block[1 << 16];
+            size_t length;
+            while ((length = std::fread(block, 1, sizeof(block), out)) != 0) output.append(block, length);
+            std::fclose(in);
+            std::fclose(out);
+            return returnid;
+        }
+    };
+
+    struct _crc32_table {
+        unsigned value[4][256];
+
+        _crc32_table() {
+            for (unsigned i = 0; i < 256; i++) {
+                unsigned crc = i;
+                for (int k = 0; k < 8; k++) crc = crc & 1 ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+                value[0][i] = crc;
+            }
+            for (unsigned i = 0; i < 256; i++)
+                for (int k = 1; k < 4; k++) value[k][i] = (value[k - 1][i] >> 8) ^ value[0][value[k - 1][i] & 0xFF];
+        }
+    };
+
+    unsigned _crc32(unsigned crc, const char* data, size_t size) {
+        static const _crc32_table table;
+        const unsigned char* ptr = reinterpret_cast<const unsigned char*>(data);
+        crc = ~crc;
+        for (; size >= 4; size -= 4, ptr += 4) {
+            crc ^= ptr[0] | ptr[1] << 8 | ptr[2] << 16 | (unsigned)ptr[3] << 24;
+            crc = table.value[3][crc & 0xFF] ^ table.value[2][(crc >> 8) & 0xFF] ^ table.value[1][(crc >> 16) & 0xFF] ^ table.value[0][crc >> 24];
+        }
+        while (size--) crc = table.value[0][(crc ^ *ptr++) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    struct _deflate_tables {
+        unsigned short length_base[29], distance_base[30];
+        unsigned char length_extra[29], distance_extra[30], length_code[259], distance_code[512];
+
+        _deflate_tables() {
+            for (int code = 0, length = 3; code < 29; code++) {
+                length_extra[code] = code < 8 || code == 28 ? 0 : (code - 4) / 4;
+                length_base[code] = code == 28 ? 258 : length;
+                for (int i = 0; i < (1 << length_extra[code]) && length + i <= 258; i++) length_code[length + i] = code;
+                length += 1 << length_extra[code];
+            }
+            length_code[258] = 28;
+            for (int code = 0, distance = 1; code < 30; code++) {
+                distance_extra[code] = code < 4 ? 0 : (code - 2) / 2;
+                distance_base[code] = distance;
+                for (int i = 0; i < (1 << distance_extra[code]); i++) {
+                    int d = distance + i - 1;
+                    distance_code[d < 256 ? d : 256 + (d >> 7)] = code;
+                }
+                distance += 1 << distance_extra[code];
+            }
+        }
+
+        int distance_symbol(int distance) const {
+            return distance_code[distance <= 256 ? distance - 1 : 256 + ((distance - 1) >> 7)];
+        }
+    };
+
+    class _deflater {
+    private:
+        enum : int { window_size = 1 << 15, hash_bits = 15, hash_size = 1 << hash_bits, hash_bytes = 4, min_match = 3, max_match = 258 };
+        enum : int { lookahead = max_match + hash_bytes, max_chain = 1, nice_match = 16, block_symbols = 1 << 15 };
+
+        const _deflate_tables& tables;
+        std::unique_ptr<unsigned char[]> window;
+        std::unique_ptr<int[]> head, prev;
+        std::unique_ptr<unsigned[]> symbols;
+        int pos, end, symbol_count;
+        unsigned literal_freq[286], distance_freq[30], byte_freq[256];
+        unsigned char literal_cost[286], distance_cost[30];
+        unsigned long long bit_buffer;
+        int bit_count;
+
+        static const _deflate_tables& _tables() {
+            static const _deflate_tables value;
+            return value;
+        }
+
+        static void _build_lengths(const unsigned* freq, int count, int max_bits, unsigned char* result) {
+            std::vector<int> symbols;
+            std::vector<unsigned long long> weight;
+            for (int i = 0; i < count; i++) {
+                result[i] = 0;
+                if (freq[i]) symbols.push_back(i);
+            }
+            for (int i = 0; symbols.size() < 2; i++)
+                if (!freq[i]) symbols.push_back(i);
+            std::sort(symbols.begin(), symbols.end(), [&](int a, int b) { return freq[a] != freq[b] ? freq[a] < freq[b] : a < b; });
+            int n = symbols.size(), leaf = 0, inner = n;
+            std::vector<int> parent(2 * n - 1), depth(2 * n - 1);
+            for (int symbol : symbols) weight.push_back(std::max(freq[symbol], 1u));
+            weight.resize(2 * n - 1);
+            for (int node = n; node < 2 * n - 1; node++) {
+                for (int k = 0; k < 2; k++) {
+                    int child = leaf < n && (inner == node || weight[leaf] <= weight[inner]) ? leaf++ : inner++;
+                    parent[child] = node;
+                    weight[node] += weight[child];
+                }
+            }
+            depth[2 * n - 2] = 0;
+            std::vector<int> count_of(std::max(max_bits, n) + 1);
+            for (int node = 2 * n - 3; node >= 0; node--) {
+                depth[node] = depth[parent[node]] + 1;
+                if (node < n) count_of[std::min(depth[node], max_bits)]++;
+            }
+            unsigned long long total = 0;
+            for (int bits = 1; bits <= max_bits; bits++) total += (unsigned long long)count_of[bits] << (max_bits - bits);
+            for (; total > (1ULL << max_bits); total--) {
+                count_of[max_bits]--;
+                for (int bits = max_bits - 1; bits > 0; bits--) {
+                    if (count_of[bits]) {
+                        count_of[bits]--;
+                        count_of[bits + 1] += 2;
+                        break;
+                    }
+                }
+            }
+            for (int bits = max_bits, k = 0; bits > 0; bits--)
+                for (int c = count_of[bits]; c > 0; c--) result[symbols[k++]] = bits;
+        }
+
+        static void _build_codes(const unsigned char* length, int count, unsigned short* codes) {
+            unsigned bit_count[16] = {0}, next[16] = {0};
+            for (int i = 0; i < count; i++) bit_count[length[i]]++;
+            bit_count[0] = 0;
+            for (int bits = 1, code = 0; bits < 16; bits++) next[bits] = code = (code + bit_count[bits - 1]) << 1;
+            for (int i = 0; i < count; i++) {
+                if (!length[i]) continue;
+                unsigned code = next[length[i]]++, reversed = 0;
+                for (int bits = 0; bits < length[i]; bits++, code >>= 1) reversed = (reversed << 1) | (code & 1);
+                codes[i] = reversed;
+            }
+        }
+
+        void _put_bits(unsigned value, int bits) {
+            bit_buffer |= (unsigned long long)value << bit_count;
+            bit_count += bits;
+            if (bit_count >= 32) {
+                char bytes[4] = {char(bit_buffer), char(bit_buffer >> 8), char(bit_buffer >> 16), char(bit_buffer >> 24)};
+                out.append(bytes, 4);
+                bit_buffer >>= 32;
+                bit_count -= 32;
+            }
+        }
+
+        int _hash(int p) const {
+            unsigned key;
+            std::memcpy(&key, window.get() + p, hash_bytes);
+            return key * 2654435761u >> (32 - hash_bits);
+        }
+
+        int _insert(int p) {
+            int h = _hash(p), candidate = head[h];
+            prev[p & (window_size - 1)] = candidate;
+            head[h] = p;
+            return candidate;
+        }
+
+        void _slide() {
+            std::memmove(window.get(), window.get() + window_size, end - window_size);
+            pos -= window_size;
+            end -= window_size;
+            for (int i = 0; i < hash_size; i++) head[i] = head[i] >= window_size ? head[i] - window_size : -1;
+            for (int i = 0; i < window_size; i++) prev[i] = prev[i] >= window_size ? prev[i] - window_size : -1;
+        }
+
+        bool _worth(int length, int distance) const {
+            if (length >= nice_match) return true;
+            int code = tables.length_code[length], symbol = tables.distance_symbol(distance), cost = 0;
+            for (int i = 0; i < length; i++) cost += literal_cost[window[pos + i]];
+            return literal_cost[257 + code] + tables.length_extra[code] + distance_cost[symbol] + tables.distance_extra[symbol] < cost;
+        }
+
+        void _process(bool final) {
+            while (end - pos >= (final ? 1 : lookahead)) {
+                int available = end - pos, best_length = 0, best_distance = 0;
+                if (available >= hash_bytes) {
+                    int limit = std::min<int>(available, max_match), chain = max_chain;
+                    const unsigned char* current = window.get() + pos;
+                    for (int candidate = _insert(pos); candidate >= 0 && pos - candidate <= window_size && chain--; candidate = prev[candidate & (window_size - 1)]) {
+                        const unsigned char* match = window.get() + candidate;
+                        if (match[best_length] != current[best_length] || match[0] != current[0]) continue;
+                        int length = 0;
+                        for (unsigned long long a, b; length + 8 <= limit; length += 8) {
+                            std::memcpy(&a, match + length, 8);
+                            std::memcpy(&b, current + length, 8);
+                            if (a != b) break;
+                        }
+                        while (length < limit && match[length] == current[length]) length++;
+                        if (length > best_length) {
+                            best_length = length;
+                            best_distance = pos - candidate;
+                            if (length >= nice_match || length == limit) break;
+                        }
+                    }
+                }
+                if (best_length >= min_match && _worth(best_length, best_distance)) {
+                    symbols[symbol_count++] = best_distance << 9 | best_length;
+                    literal_freq[257 + tables.length_code[best_length]]++;
+                    distance_freq[tables.distance_symbol(best_distance)]++;
+                    int next = pos + best_length;
+                    for (int stop = std::min(next, end - hash_bytes + 1); ++pos < stop;) _insert(pos);
+                    pos = next;
+                } else {
+                    symbols[symbol_count++] = window[pos];
+                    literal_freq[window[pos]]++;
+                    pos++;
+                }
+                if (symbol_count == block_symbols) _flush_block(false);
+            }
+        }
+
+        void _flush_block(bool final) {
+            static const unsigned char order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+            unsigned char literal_length[288] = {0}, distance_length[30], code_length[19], all[316];
+            unsigned short literal_code[288], distance_code[30], length_code[19];
+            unsigned code_freq[19] = {0};
+            literal_freq[256]++;
+            _build_lengths(literal_freq, 286, 15, literal_length);
+            _build_lengths(distance_freq, 30, 15, distance_length);
+            unsigned long long bytes = std::accumulate(byte_freq, byte_freq + 256, 0ULL);
+            if (bytes) {
+                for (int i = 0; i < 256; i++) literal_cost[i] = byte_freq[i] ? std::min(15, std::max(1, (int)std::lround(std::log2((double)bytes / byte_freq[i])))) : 15;
+                std::fill(byte_freq, byte_freq + 256, 0);
+            }
+            for (int i = 256; i < 286; i++) literal_cost[i] = literal_length[i] ? literal_length[i] : 15;
+            for (int i = 0; i < 30; i++) distance_cost[i] = distance_length[i] ? distance_length[i] : 15;
+            int literals = 286, dists = 30;
+            while (literals > 257 && !literal_length[literals - 1]) literals--;
+            while (dists > 1 && !distance_length[dists - 1]) dists--;
+            std::memcpy(all, literal_length, literals);
+            std::memcpy(all + literals, distance_length, dists);
+            std::vector<std::pair<int, int>> runs;
+            for (int i = 0, total = literals + dists; i < total;) {
+                int run = 1;
+                while (i + run < total && all[i + run] == all[i]) run++;
+                i += run;
+                if (all[i - run] == 0) {
+                    for (; run >= 11; run -= std::min(run, 138)) runs.emplace_back(18, std::min(run, 138) - 11);
+                    if (run >= 3) {
+                        runs.emplace_back(17, run - 3);
+                        run = 0;
+                    }
+                } else {
+                    runs.emplace_back(all[i - run], 0);
+                    run--;
+                    for (; run >= 3; run -= std::min(run, 6)) runs.emplace_back(16, std::min(run, 6) - 3);
+                }
+                for (; run > 0; run--) runs.emplace_back(all[i - run], 0);
+            }
+            for (auto& run : runs) code_freq[run.first]++;
+            _build_lengths(code_freq, 19, 7, code_length);
+            _build_codes(code_length, 19, length_code);
+            int codes = 19;
+            while (codes > 4 && !code_length[order[codes - 1]]) codes--;
+            unsigned long long dynamic_bits = 14 + 3 * codes, fixed_bits = 0;
+            for (auto& run : runs) dynamic_bits += code_length[run.first] + (run.first == 16 ? 2 : run.first == 17 ? 3 : run.first == 18 ? 7 : 0);
+            for (int i = 0; i < 286; i++) {
+                dynamic_bits += (unsigned long long)literal_freq[i] * literal_length[i];
+                fixed_bits += (unsigned long long)literal_freq[i] * (i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8);
+            }
+            for (int i = 0; i < 30; i++) {
+                dynamic_bits += (unsigned long long)distance_freq[i] * distance_length[i];
+                fixed_bits += (unsigned long long)distance_freq[i] * 5;
+            }
+            _put_bits(final, 1);
+            if (fixed_bits <= dynamic_bits) {
+                for (int i = 0; i < 288; i++) literal_length[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+                std::fill(distance_length, distance_length + 30, 5);
+                _put_bits(1, 2);
+            } else {
+                _put_bits(2, 2);
+                _put_bits(literals - 257, 5);
+                _put_bits(dists - 1, 5);
+                _put_bits(codes - 4, 4);
+                for (int i = 0; i < codes; i++) _put_bits(code_length[order[i]], 3);
+                for (auto& run : runs) {
+                    _put_bits(length_code[run.first], code_length[run.first]);
+                    if (run.first >= 16) _put_bits(run.second, run.first == 16 ? 2 : run.first == 17 ? 3 : 7);
+                }
+            }
+            _build_codes(literal_length, 288, literal_code);
+            _build_codes(distance_length, 30, distance_code);
+            for (int i = 0; i < symbol_count; i++) {
+                int length = symbols[i] & 511, distance = symbols[i] >> 9;
+                if (!distance) {
+                    _put_bits(literal_code[length], literal_length[length]);
+                    continue;
+                }
+                int code = tables.length_code[length], symbol = tables.distance_symbol(distance);
+                _put_bits(literal_code[257 + code], literal_length[257 + code]);
+                _put_bits(length - tables.length_base[code], tables.length_extra[code]);
+                _put_bits(distance_code[symbol], distance_length[symbol]);
+                _put_bits(distance - tables.distance_base[symbol], tables.distance_extra[symbol]);
+            }
+            _put_bits(literal_code[256], literal_length[256]);
+            symbol_count = 0;
+            std::fill(literal_freq, literal_freq + 286, 0);
+            std::fill(distance_freq, distance_freq + 30, 0);
+        }
+
+    public:
+        string out;
+
+        _deflater() : tables(_tables()), window(new unsigned char[2 * window_size]), head(new int[hash_size]), prev(new int[window_size]), symbols(new unsigned[block_symbols]), pos(0), end(0), symbol_count(0), bit_buffer(0), bit_count(0) {
+            std::fill(head.get(), head.get() + hash_size, -1);
+            std::fill(prev.get(), prev.get() + window_size, -1);
+            std::fill(literal_freq, literal_freq + 286, 0);
+            std::fill(distance_freq, distance_freq + 30, 0);
+            std::fill(byte_freq, byte_freq + 256, 0);
+            std::fill(literal_cost, literal_cost + 286, 8);
+            std::fill(distance_cost, distance_cost + 30, 5);
+        }
+
+        void write(const char* data, size_t size) {
+            while (size) {
+                if (end == 2 * window_size) _slide();
+                size_t length = std::min(size, size_t(2 * window_size - end));
+                std::memcpy(window.get() + end, data, length);
+                for (size_t i = 0; i < length; i++) byte_freq[(unsigned char)data[i]]++;
+                end += length;
+                data += length;
+                size -= length;
+                _process(false);
+            }
+        }
+
+        void finish() {
+            _process(true);
+            _flush_block(true);
+            for (; bit_count > 0; bit_count -= 8, bit_buffer >>= 8) out.push_back(char(bit_buffer));
+            bit_count = 0;
+        }
+    };
+
+    class zip_archive {
+    public:
+        enum method_type { store = 0, deflate = 8 };
+
+    private:
+        struct record {
+            string name;
+            unsigned method, crc;
+            unsigned long long compressed, size, offset;
+            string data;
+        };
+
+    public:
+        class entry {
+        private:
+            zip_archive* archive;
+            record info;
+            std::unique_ptr<_deflater> deflater;
+            bool direct, closed;
+
+            entry(zip_archive* archive, const string& name, bool direct) : archive(archive), direct(direct), closed(false) {
+                info.name = name;
+                info.method = archive->method;
+                info.crc = 0;
+                info.compressed = info.size = 0;
+                info.offset = archive->offset;
+                if (info.method == deflate) deflater.reset(new _deflater());
+            }
+
+            int _emit(const char* data, size_t size) {
+                info.compressed += size;
+                if (direct) return _write_fd(archive->fd, data, size);
+                info.data.append(data, size);
+                return 0;
+            }
+
+            friend class zip_archive;
+
+        public:
+            entry(const entry&) = delete;
+            entry& operator=(const entry&) = delete;
+
+            ~entry() {
+                try {
+                    close();
+                } catch (...) {
+                }
+            }
+
+            int _write(const char* data, size_t size) {
+                if (closed) return EBADF;
+                info.crc = _crc32(info.crc, data, size);
+                info.size += size;
+                if (!deflater) return _emit(data, size);
+                deflater->write(data, size);
+                int error = _emit(deflater->out.data(), deflater->out.size());
+                deflater->out.clear();
+                return error;
+            }
+
+            void write(const char* data, size_t size) {
+                if (_write(data, size)) raise(carefree_file_exception("zip_archive::entry::write : failed to write " + info.name + " into " + archive->_filename));
+            }
+
+            void write(const string& data) {
+                write(data.data(), data.size());
+            }
+
+            void close() {
+                if (closed) return;
+                int error = 0;
+                if (deflater) {
+                    deflater->finish();
+                    error = _emit(deflater->out.data(), deflater->out.size());
+                    deflater.reset();
+                }
+                closed = true;
+                if (archive->_commit(info, direct, error)) raise(carefree_file_exception("zip_archive::entry::close : failed to write " + info.name + " into " + archive->_filename));
+            }
+        };
+
+    private:
+        int fd;
+        method_type method;
+        std::mutex lock;
+        std::vector<record> records, queue;
+        unsigned long long offset;
+        unsigned dos_time, dos_date, temporaries;
+        size_t opened;
+        bool streaming;
+        int failure;
+
+        static int _write_fd(int fd, const char* data, size_t size) {
+            while (size) {
+                auto written = ::write(fd, data, size);
+                if (written < 0) {
+                    if (errno == EINTR) continue;
+                    return errno;
+                }
+                data += written;
+                size -= written;
+            }
+            return 0;
+        }
+
+        string _header(const record& info, bool central) const {
+            string header;
+            auto put = [&](unsigned long long value, int bytes) {
+                for (int i = 0; i < bytes; i++) header.push_back(char(value >> (8 * i)));
+            };
+            put(central ? 0x02014b50 : 0x04034b50, 4);
+            if (central) put(20, 2);
+            put(20, 2);
+            put(0x0800, 2);
+            put(info.method, 2);
+            put(dos_time, 2);
+            put(dos_date, 2);
+            put(info.crc, 4);
+            put(info.compressed, 4);
+            put(info.size, 4);
+            put(info.name.size(), 2);
+            put(0, 2);
+            if (central) {
+                put(0, 6);
+                put(0, 4);
+                put(info.offset, 4);
+            }
+            return header + info.name;
+        }
+
+        int _append(record& info) {
+            info.offset = offset;
+            string header = _header(info, false);
+            if (offset + header.size() + info.compressed > 0xFFFFFFFFULL) return EFBIG;
+            int error = _write_fd(fd, header.data(), header.size());
+            if (!error) error = _write_fd(fd, info.data.data(), info.data.size());
+            if (error) return error;
+            offset += header.size() + info.compressed;
+            info.data = string();
+            records.push_back(std::move(info));
+            return 0;
+        }
+
+        int _patch(const record& info) {
+            if (info.size > 0xFFFFFFFFULL || info.offset + 30 + info.name.size() + info.compressed > 0xFFFFFFFFULL) return EFBIG;
+            char fields[12];
+            unsigned long long values[3] = {info.crc, info.compressed, info.size};
+            for (int i = 0; i < 12; i++) fields[i] = char(values[i / 4] >> (8 * (i % 4)));
+            if (lseek(fd, info.offset + 14, SEEK_SET) == -1) return errno;
+            int error = _write_fd(fd, fields, sizeof(fields));
+            if (lseek(fd, 0, SEEK_END) == -1 && !error) error = errno;
+            return error;
+        }
+
+        int _commit(record& info, bool direct, int error) {
+            std::lock_guard<std::mutex> guard(lock);
+            opened--;
+            if (direct) {
+                streaming = false;
+                if (!error) error = _patch(info);
+                if (!error) {
+                    offset = info.offset + 30 + info.name.size() + info.compressed;
+                    records.push_back(info);
+                }
+                for (auto& item : queue)
+                    if (!error) error = _append(item);
+                queue.clear();
+            } else if (!error) {
+                if (info.size > 0xFFFFFFFFULL)
+                    error = EFBIG;
+                else if (streaming)
+                    queue.push_back(std::move(info));
+                else
+                    error = _append(info);
+            }
+            if (error && !failure) failure = error;
+            return error;
+        }
+
+    public:
+        string _filename;
+
+        zip_archive(const string& filename, method_type method = deflate) : fd(-1), method(method), offset(0), temporaries(0), opened(0), streaming(false), failure(0), _filename(filename) {
+            std::time_t now = std::time(nullptr);
+            std::tm* local = std::localtime(&now);
+            dos_time = local->tm_hour << 11 | local->tm_min << 5 | local->tm_sec / 2;
+            dos_date = (local->tm_year - 80) << 9 | (local->tm_mon + 1) << 5 | local->tm_mday;
+            fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | O_BINARY, 0644);
+            if (fd == -1) raise(carefree_file_exception("zip_archive::zip_archive : cannot open file " + filename));
+        }
 
-    graph random_tree(int n, _Weight weightL = 0, _Weight weightR = 0) {
-        graph g(n, false);
-        std::vector<int> prufer;
-        for (int i = 1; i <= n - 2; i++) prufer.push_back(randint(1, n));
-        return prufer_decode(n, prufer, weightL, weightR);
-    }
+        zip_archive(const zip_archive&) = delete;
+        zip_archive& operator=(const zip_archive&) = delete;
 
-    graph dag(int n, int m, bool repeat_edges = false, _Weight weightL = 0, _Weight weightR = 0) {
-        graph tree = random_tree(n, weightL, weightR);
-        auto depth = get_depth(tree);
-        graph ret = externalize(tree);
-        err_geq_checker(m, n - 1, __func__, "m");
-        for (int i = n; i <= m; i++) {
-            while (true) {
-                int u = randint(1, n);
-                int v = randint(1, n);
-                if (u == v) continue;
-                if (depth[u] > depth[v]) std::swap(u, v);
-                if (!repeat_edges && ret.has_edge(u, v)) continue;
-                ret.add(u, v, randint(weightL, weightR));
-                break;
+        ~zip_archive() {
+            try {
+                close();
+            } catch (...) {
             }
         }
-        return ret;
-    }
 
-    graph connected_undirected_graph(int n, int m, bool repeat_edges = false, bool self_loop = false, _Weight weightL = 0, _Weight weightR = 0) {
-        graph tree = random_tree(n, weightL, weightR);
-        graph ret = tree;
-        err_geq_checker(m, n - 1, __func__, "m");
-        for (int i = n; i <= m; i++) {
-            while (true) {
-                int u = randint(1, n);
-                int v = randint(1, n);
-                if (!self_loop && u == v) continue;
-                if (!repeat_edges && ret.has_edge(u, v)) continue;
-                ret.add(u, v, randint(weightL, weightR));
-                break;
+        std::unique_ptr<entry> open_entry(const string& name) {
+            std::lock_guard<std::mutex> guard(lock);
+            if (fd == -1) {
+                raise(carefree_file_exception("zip_archive::open_entry : archive " + _filename + " is not opened."));
+                return nullptr;
             }
+            if (name.size() > 0xFFFF) {
+                raise(carefree_invalid_argument("zip_archive::open_entry : entry name is too long."));
+                return nullptr;
+            }
+            std::unique_ptr<entry> item(new entry(this, name, !streaming));
+            if (!streaming) {
+                string header = _header(item->info, false);
+                if (_write_fd(fd, header.data(), header.size())) {
+                    item->closed = true;
+                    raise(carefree_file_exception("zip_archive::open_entry : failed to write file " + _filename));
+                    return nullptr;
+                }
+                streaming = true;
+            }
+            opened++;
+            return item;
         }
-        return ret;
-    }
 
-    graph connected_directed_graph(int n, int m, bool repeat_edges = false, bool self_loop = false, _Weight weightL = 0, _Weight weightR = 0) {
-        graph tree = random_tree(n, weightL, weightR);
-        graph ret = externalize(tree);
-        err_geq_checker(m, n - 1, __func__, "m");
-        for (int i = n; i <= m; i++) {
-            while (true) {
-                int u = randint(1, n);
-                int v = randint(1, n);
-                if (!self_loop && u == v) continue;
-                if (!repeat_edges && ret.has_edge(u, v)) continue;
-                ret.add(u, v, randint(weightL, weightR));
-                break;
-            }
+        void add(const string& name, const string& content) {
+            auto item = open_entry(name);
+            if (item == nullptr) return;
+            item->write(content);
+            item->close();
         }
-        return ret;
-    }
 
-    graph random_graph(int n, int m, bool directed = true, bool repeat_edges = false, bool self_loop = false, _Weight weightL = 0, _Weight weightR = 0) {
-        graph ret(n, directed);
-        for (int i = 1; i <= m; i++) {
-            while (true) {
-                int u = randint(1, n);
-                int v = randint(1, n);
-                if (!self_loop && u == v) continue;
-                if (!repeat_edges && ret.has_edge(u, v)) continue;
-                ret.add(u, v, randint(weightL, weightR));
-                break;
+        string _temporary_name() {
+            std::lock_guard<std::mutex> guard(lock);
+            return _filename + "." + std::to_string(temporaries++) + ".tmp";
+        }
+
+        void close() {
+            std::lock_guard<std::mutex> guard(lock);
+            if (fd == -1) return;
+            if (opened) {
+                raise(carefree_unsupported_operation("zip_archive::close : some entries of " + _filename + " are still open."));
+                return;
             }
+            string directory;
+            for (auto& info : records) directory += _header(info, true);
+            unsigned long long values[] = {0x06054b50, 0, 0, records.size(), records.size(), directory.size(), offset, 0};
+            int widths[] = {4, 2, 2, 2, 2, 4, 4, 2};
+            for (int i = 0; i < 8; i++)
+                for (int k = 0; k < widths[i]; k++) directory.push_back(char(values[i] >> (8 * k)));
+            int error = failure;
+            if (!error && (records.size() > 0xFFFF || offset + directory.size() > 0xFFFFFFFFULL)) error = EFBIG;
+            if (!error) error = _write_fd(fd, directory.data(), directory.size());
+            int handle = fd;
+            fd = -1;
+            if (::close(handle) || error) raise(carefree_file_exception("zip_archive::close : failed to write archive " + _filename));
         }
-        return ret;
-    }
+    };
 
     class testcase_writer {
     private:
         class file_writer {
         private:
-            std::FILE* fp;
-            void _ein() {
-                if (fp == nullptr) raise(carefree_file_exception("testcase_writer::file_writer::_ein : file is not opened."));
+            struct async_state {
+                std::mutex lock;
+                std::condition_variable cond;
+                std::unique_ptr<char[]> pending;
+                size_t pending_size;
+                bool busy, stop;
+                int error;
+                std::thread worker;
+            };
+
+            int fd, tee;
+            std::unique_ptr<char[]> buffer;
+            size_t capacity, used, window;
+            unsigned long long flushed, limit;
+            unsigned precision;
+            bool reserved;
+            std::unique_ptr<async_state> async;
+            std::unique_ptr<zip_archive::entry> entry;
+
+            bool _ein() {
+                if (fd != -1 || entry) return true;
+                raise(carefree_file_exception("testcase_writer::file_writer::_ein : file is not opened."));
+                return false;
+            }
+
+            bool _reject() {
+                raise(carefree_range_exception("testcase_writer::file_writer : writing " + _filename + " would exceed the size limit of " + std::to_string(limit) + " bytes."));
+                return false;
+            }
+
+            bool _admit(size_t size) {
+                return flushed + used + size <= limit || _reject();
+            }
+
+            void _update_window() {
+                window = flushed >= limit ? 0 : std::min<unsigned long long>(capacity, limit - flushed);
+            }
+
+            int _write_all(const char* data, size_t size) {
+                if (tee != -1 && _pipe_write(tee, data, size)) tee = -1;
+                if (entry) return entry->_write(data, size);
+                while (size) {
+                    auto written = ::write(fd, data, size);
+                    if (written < 0) {
+                        if (errno == EINTR) continue;
+                        return errno;
+                    }
+                    data += written;
+                    size -= written;
+                }
+                return 0;
+            }
+
+            void _write_fd(const char* data, size_t size) {
+                if (_write_all(data, size)) raise(carefree_file_exception("testcase_writer::file_writer::flush : failed to write file " + _filename));
+            }
+
+            void _async_loop() {
+                std::unique_lock<std::mutex> guard(async->lock);
+                while (true) {
+                    async->cond.wait(guard, [this] { return async->busy || async->stop; });
+                    if (!async->busy) return;
+                    guard.unlock();
+                    int error = _write_all(async->pending.get(), async->pending_size);
+                    guard.lock();
+                    if (error && !async->error) async->error = error;
+                    async->busy = false;
+                    async->cond.notify_all();
+                }
+            }
+
+            void _wait_async() {
+                if (!async) return;
+                int error;
+                {
+                    std::unique_lock<std::mutex> guard(async->lock);
+                    async->cond.wait(guard, [this] { return !async->busy; });
+                    error = async->error;
+                    async->error = 0;
+                }
+                if (error) raise(carefree_file_exception("testcase_writer::file_writer::flush : failed to write file " + _filename));
+            }
+
+            void _flush_buffer() {
+                flushed += used;
+                _update_window();
+                if (!async) {
+                    _write_fd(buffer.get(), used);
+                    used = 0;
+                    return;
+                }
+                if (!used) return;
+                _wait_async();
+                {
+                    std::lock_guard<std::mutex> guard(async->lock);
+                    std::swap(buffer, async->pending);
+                    async->pending_size = used;
+                    async->busy = true;
+                }
+                async->cond.notify_all();
+                used = 0;
+            }
+
+            void _stop_async() {
+                {
+                    std::lock_guard<std::mutex> guard(async->lock);
+                    async->stop = true;
+                }
+                async->cond.notify_all();
+                async->worker.join();
+                async.reset();
+            }
+
+            __attribute__((noinline)) void _write_through(const char* val, size_t size) {
+                if (!_admit(size)) return;
+                _flush_buffer();
+                if (size > capacity) {
+                    _wait_async();
+                    flushed += size;
+                    _update_window();
+                    return _write_fd(val, size);
+                }
+                std::memcpy(buffer.get(), val, size);
+                used = size;
+            }
+
+            template <class T>
+            void _write_digits(bool negative, T magnitude) {
+                char digits[48], *ptr = _format_unsigned(magnitude, digits + sizeof(digits));
+                if (negative) *(--ptr) = '-';
+                writeString(ptr, digits + sizeof(digits) - ptr);
             }
 
         public:
             string _filename;
-            file_writer() {}
-            file_writer(const char* filename) {
+            file_writer() : fd(-1), tee(-1), capacity(0), used(0), window(0), flushed(0), limit(~0ULL), precision(10), reserved(false) {}
+            file_writer(const char* filename, size_t capacity = 1 << 20) : fd(-1), tee(-1), capacity(capacity), used(0), window(capacity), flushed(0), limit(~0ULL), precision(10), reserved(false) {
+                _filename = filename;
+                if (std::strlen(filename)) {
+                    fd = ::open(filename, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+                    if (fd == -1) raise(carefree_file_exception("testcase_writer::file_writer::file_writer : cannot open file " + _filename));
+                    buffer.reset(new char[capacity]);
+                }
+            }
+            file_writer(zip_archive& archive, const char* filename, size_t capacity = 1 << 20) : fd(-1), tee(-1), capacity(capacity), used(0), window(capacity), flushed(0), limit(~0ULL), precision(10), reserved(false) {
                 _filename = filename;
                 if (std::strlen(filename)) {
-                    fp = std::fopen(filename, "w");
-                    if (fp == NULL) raise(carefree_file_exception("testcase_writer::file_writer::file_writer : cannot open file " + _filename));
-                } else
-                    fp = nullptr;
+                    entry = archive.open_entry(filename);
+                    buffer.reset(new char[capacity]);
+                }
+            }
+            file_writer(const file_writer&) = delete;
+            file_writer& operator=(const file_writer&) = delete;
+            void set_async(bool enable) {
+                if ((fd == -1 && !entry) || enable == bool(async)) return;
+                if (!enable) {
+                    flush();
+                    return _stop_async();
+                }
+                async.reset(new async_state());
+                async->pending.reset(new char[capacity]);
+                async->pending_size = 0;
+                async->busy = async->stop = false;
+                async->error = 0;
+                async->worker = std::thread(&file_writer::_async_loop, this);
             }
             void close() {
-                if (fp != nullptr) std::fclose(fp);
+                if (fd == -1 && !entry) return;
+                int handle = fd;
+                if (async) {
+                    try {
+                        flush();
+                    } catch (...) {
+                        _stop_async();
+                        fd = tee = -1;
+                        if (handle != -1) ::close(handle);
+                        entry.reset();
+                        throw;
+                    }
+                    _stop_async();
+                } else if (used)
+                    _flush_buffer();
+                fd = tee = -1;
+                if (entry) {
+                    auto current = std::move(entry);
+                    return current->close();
+                }
+                if (reserved && ftruncate(handle, lseek(handle, 0, SEEK_CUR))) {
+                    ::close(handle);
+                    raise(carefree_file_exception("testcase_writer::file_writer::close : failed to truncate file " + _filename));
+                    return;
+                }
+                if (::close(handle)) raise(carefree_file_exception("testcase_writer::file_writer::close : failed to close file " + _filename));
+            }
+            ~file_writer() {
+                try {
+                    close();
+                } catch (...) {
+                }
+            }
+            void reserve(unsigned long long size) {
+                if (fd != -1 && _preallocate(fd, size)) reserved = true;
+            }
+            void setLimit(unsigned long long limit) {
+                this->limit = limit;
+                _update_window();
             }
-            ~file_writer() { close(); }
             void writeChar(char val) {
-                _ein();
-                std::fputc(val, fp);
+                if (!_ein()) return;
+                if (used >= window) return _write_through(&val, 1);
+                buffer[used++] = val;
             }
             template <class T>
             void writeInteger(T val) {
-                _ein();
-                if (val < 0) {
-                    val = -val;
-                    writeChar('-');
+                bool negative = val < 0;
+                if (sizeof(T) <= sizeof(unsigned))
+                    _write_digits(negative, negative ? 0U - (unsigned)val : (unsigned)val);
+                else
+                    _write_digits(negative, negative ? 0ULL - (unsigned long long)val : (unsigned long long)val);
+            }
+#ifdef CAREFREE_INT128_SUPPORT
+            void writeInteger(__int128 val) {
+                bool negative = val < 0;
+                _write_digits(negative, negative ? (unsigned __int128)0 - (unsigned __int128)val : (unsigned __int128)val);
+            }
+            void writeInteger(unsigned __int128 val) {
+                _write_digits(false, val);
+            }
+#endif
+            void setTee(int tee) {
+                this->tee = tee;
+            }
+            unsigned long long bytesWritten() const {
+                return flushed + used;
+            }
+            void setPrecision(unsigned precision) {
+                this->precision = precision;
+            }
+            unsigned getPrecision() const {
+                return precision;
+            }
+            template <class T>
+            void writeFloat(T val, unsigned precision) {
+                if (!_ein()) return;
+                size_t bound = _float_length_bound<T>(precision);
+                if (capacity - used < bound) _flush_buffer();
+                if (capacity < bound) {
+                    std::unique_ptr<char[]> digits(new char[bound]);
+                    return writeString(digits.get(), _format_float(val, precision, digits.get()) - digits.get());
                 }
-                if (val == 0) {
-                    writeChar('0');
-                    return;
+                size_t length = _format_float(val, precision, buffer.get() + used) - (buffer.get() + used);
+                if (used + length <= window || _admit(length)) used += length;
+            }
+            template <class T>
+            void writeFloat(T val) {
+                writeFloat(val, precision);
+            }
+            template <class T>
+            void writeFloats(const T* val, size_t size, unsigned precision) {
+                if (!_ein()) return;
+                size_t bound = _float_length_bound<T>(precision) + 1;
+                for (size_t i = 0; i < size; i++) {
+                    if (capacity - used < bound) {
+                        if (i) writeChar(' ');
+                        writeFloat(val[i], precision);
+                        continue;
+                    }
+                    char *first = buffer.get() + used, *out = first;
+                    if (i) *(out++) = ' ';
+                    size_t length = _format_float(val[i], precision, out) - first;
+                    if (used + length > window && !_admit(length)) return;
+                    used += length;
                 }
-                if (val >= 10) writeInteger(val / 10);
-                writeChar('0' + val % 10);
+            }
+            void writeString(const char* val, size_t size) {
+                if (!_ein()) return;
+                if (used + size > window) return _write_through(val, size);
+                std::memcpy(buffer.get() + used, val, size);
+                used += size;
             }
             void writeString(const char* val) {
-                _ein();
-                const char* ptr = val;
-                while (*ptr != '\0') writeChar(*(ptr++));
+                writeString(val, std::strlen(val));
             }
-            void writeString(string val) {
-                _ein();
-                writeString(val.c_str());
+            void writeString(const string& val) {
+                writeString(val.data(), val.size());
             }
             void flush() {
-                _ein();
-                std::fflush(fp);
+                if (!_ein()) return;
+                _flush_buffer();
+                _wait_async();
             }
         };
 
         file_writer* fin;
         file_writer* fout;
         bool locked;
+        unsigned long long max_size = ~0ULL;
+        std::unique_ptr<_std_process> runner;
+        zip_archive* archive = nullptr;
+        string spool;
+
+        void _check_output_size(const char* func_name) {
+            if (output_bytes_written() > max_size) raise(carefree_range_exception(string(func_name) + " : output file " + fout->_filename + " exceeds the size limit of " + std::to_string(max_size) + " bytes."));
+        }
+
+        static void _put(file_writer& out, char val) { out.writeChar(val); }
+        static void _put(file_writer& out, bool val) { out.writeString(val ? "true" : "false"); }
+        static void _put(file_writer& out, const char* val) { out.writeString(val); }
+        static void _put(file_writer& out, const string& val) { out.writeString(val); }
+
+        template <class T>
+        static _if_integer<T> _put(file_writer& out, T val) {
+            out.writeInteger(val);
+        }
+
+        template <class T>
+        static _if_floating<T> _put(file_writer& out, T val) {
+            out.writeFloat(val);
+        }
+
+        template <class Weight, class Index>
+        static void _put(file_writer& out, const basic_graph<Weight, Index>& val) {
+            graph_format::weighted::write(out, val);
+        }
+
+        template <class Weight, class Index>
+        static void _put(file_writer& out, const basic_edge<Weight, Index>& val) {
+            graph_format::weighted::write_edge(out, val);
+        }
+
+        template <class First, class Second>
+        static void _put(file_writer& out, const std::pair<First, Second>& val) {
+            _put(out, val.first);
+            out.writeChar(' ');
+            _put(out, val.second);
+        }
+
+        template <class Tuple, size_t... I>
+        static void _put_tuple(file_writer& out, const Tuple& val, std::index_sequence<I...>) {
+            int expand[] = {0, ((I ? out.writeChar(' ') : void()), _put(out, std::get<I>(val)), 0)...};
+            (void)expand;
+        }
+
+        template <class... T>
+        static void _put(file_writer& out, const std::tuple<T...>& val) {
+            _put_tuple(out, val, std::index_sequence_for<T...>());
+        }
+
+        template <class Iterator>
+        static void _put_range(file_writer& out, Iterator first, Iterator last, const char* separator) {
+            size_t length = std::strlen(separator);
+            for (Iterator it = first; it != last; ++it) {
+                if (it != first) out.writeString(separator, length);
+                _put(out, *it);
+            }
+        }
+
+        template <class T>
+        static _if_range<T> _put(file_writer& out, const T& val) {
+            _put_range(out, std::begin(val), std::end(val), " ");
+        }
+
+        template <class Traits>
+        static void _put_segment(file_writer& out, size_t index) {
+            size_t length = Traits::layout.end[index] - Traits::layout.begin[index];
+            if (length == 1)
+                out.writeChar(Traits::layout.text[Traits::layout.begin[index]]);
+            else if (length)
+                out.writeString(Traits::layout.text + Traits::layout.begin[index], length);
+        }
+
+        template <class Traits, size_t... I, class... Args>
+        static void _putf(file_writer& out, std::index_sequence<I...>, const Args&... args) {
+            int expand[] = {0, (_put_segment<Traits>(out, I), _put(out, args), 0)...};
+            (void)expand;
+            _put_segment<Traits>(out, sizeof...(I));
+        }
+
+        template <class Grid>
+        static void _put_matrix(file_writer& out, const Grid& grid, const char* separator, const char* row_end) {
+            size_t length = std::strlen(row_end);
+            for (auto& row : grid) {
+                _put_range(out, std::begin(row), std::end(row), separator);
+                out.writeString(row_end, length);
+            }
+        }
 
         void _eil() {
             if (locked) raise(carefree_unsupported_operation("testcase_writer::_eil : input/output file has already locked."));
@@ -1036,6 +4470,18 @@ namespace carefree_internal {
             locked = false;
         }
 
+        testcase_writer(zip_archive& archive, string input_file, string output_file = "") : archive(&archive) {
+            fin = new file_writer(archive, input_file.c_str());
+            fout = new file_writer(archive, output_file.c_str());
+            locked = false;
+        }
+
+        testcase_writer(zip_archive& archive, string file_prefix, unsigned data_id, string input_suffix = ".in", string output_suffix = ".out", bool disable_output = false)
+            : testcase_writer(archive, file_prefix + std::to_string(data_id) + input_suffix, disable_output ? "" : file_prefix + std::to_string(data_id) + output_suffix) {}
+
+        testcase_writer(zip_archive& archive, string file_prefix, unsigned subtask_id, unsigned task_id, string input_suffix = ".in", string output_suffix = ".out", bool disable_output = false)
+            : testcase_writer(archive, file_prefix + std::to_string(subtask_id) + "-" + std::to_string(task_id) + input_suffix, disable_output ? "" : file_prefix + std::to_string(subtask_id) + "-" + std::to_string(task_id) + output_suffix) {}
+
         void input_write(char val) {
             _eil();
             fin->writeChar(val);
@@ -1118,11 +4564,11 @@ namespace carefree_internal {
             fout->writeInteger(val);
         }
 #endif
-        void input_write(string val) {
+        void input_write(const string& val) {
             _eil();
             fin->writeString(val);
         }
-        void output_write(string val) {
+        void output_write(const string& val) {
             _eil();
             fout->writeString(val);
         }
@@ -1136,6 +4582,30 @@ namespace carefree_internal {
             fout->writeString(val);
         }
 
+        template <class T>
+        _if_floating<T> input_write(T val) {
+            _eil();
+            fin->writeFloat(val);
+        }
+        template <class T>
+        _if_floating<T> output_write(T val) {
+            _eil();
+            fout->writeFloat(val);
+        }
+
+        template <class T>
+        _if_floating<T> input_write(T val, int precision) {
+            _eil();
+            err_natural_checker(precision, __func__, "precision");
+            fin->writeFloat(val, precision);
+        }
+        template <class T>
+        _if_floating<T> output_write(T val, int precision) {
+            _eil();
+            err_natural_checker(precision, __func__, "precision");
+            fout->writeFloat(val, precision);
+        }
+
         void input_write(bool val) {
             _eil();
             fin->writeString(val ? "true" : "false");
@@ -1146,42 +4616,126 @@ namespace carefree_internal {
         }
 
         template <class T>
-        void input_write(std::vector<T> val) {
+        _if_integer<T> input_write(T val) {
             _eil();
-            for (auto it = val.begin(); it != val.end(); ++it) {
-                input_write(*it);
-                if ((it + 1) != val.end()) input_write(' ');
-            }
+            fin->writeInteger(val);
         }
         template <class T>
-        void output_write(std::vector<T> val) {
+        _if_integer<T> output_write(T val) {
             _eil();
-            for (auto it = val.begin(); it != val.end(); ++it) {
-                output_write(*it);
-                if ((it + 1) != val.end()) output_write(' ');
-            }
+            fout->writeInteger(val);
+        }
+
+        template <class T>
+        _if_range<T> input_write(const T& val) {
+            _eil();
+            _put(*fin, val);
+        }
+        template <class T>
+        _if_range<T> output_write(const T& val) {
+            _eil();
+            _put(*fout, val);
+        }
+
+        template <class First, class Second>
+        void input_write(const std::pair<First, Second>& val) {
+            _eil();
+            _put(*fin, val);
+        }
+        template <class First, class Second>
+        void output_write(const std::pair<First, Second>& val) {
+            _eil();
+            _put(*fout, val);
+        }
+
+        template <class... T>
+        void input_write(const std::tuple<T...>& val) {
+            _eil();
+            _put(*fin, val);
+        }
+        template <class... T>
+        void output_write(const std::tuple<T...>& val) {
+            _eil();
+            _put(*fout, val);
+        }
+
+        template <class Iterator>
+        void input_write_range(Iterator first, Iterator last, const char* separator = " ") {
+            _eil();
+            _put_range(*fin, first, last, separator);
+        }
+        template <class Iterator>
+        void output_write_range(Iterator first, Iterator last, const char* separator = " ") {
+            _eil();
+            _put_range(*fout, first, last, separator);
+        }
+
+        template <class Range>
+        void input_write_range(const Range& val, const char* separator = " ") {
+            _eil();
+            _put_range(*fin, std::begin(val), std::end(val), separator);
+        }
+        template <class Range>
+        void output_write_range(const Range& val, const char* separator = " ") {
+            _eil();
+            _put_range(*fout, std::begin(val), std::end(val), separator);
+        }
+
+        template <class Grid>
+        void input_write_matrix(const Grid& grid, const char* separator = " ", const char* row_end = "\n") {
+            _eil();
+            _put_matrix(*fin, grid, separator, row_end);
+        }
+        template <class Grid>
+        void output_write_matrix(const Grid& grid, const char* separator = " ", const char* row_end = "\n") {
+            _eil();
+            _put_matrix(*fout, grid, separator, row_end);
+        }
+
+        void input_write(const std::vector<double>& val, int precision) {
+            _eil();
+            err_natural_checker(precision, __func__, "precision");
+            fin->writeFloats(val.data(), val.size(), precision);
+        }
+        void output_write(const std::vector<double>& val, int precision) {
+            _eil();
+            err_natural_checker(precision, __func__, "precision");
+            fout->writeFloats(val.data(), val.size(), precision);
+        }
+
+        void input_write(const std::vector<double>& val) {
+            _eil();
+            fin->writeFloats(val.data(), val.size(), fin->getPrecision());
+        }
+        void output_write(const std::vector<double>& val) {
+            _eil();
+            fout->writeFloats(val.data(), val.size(), fout->getPrecision());
         }
 
-        void input_write(graph val) {
+        template <class Format = graph_format::weighted, class Weight, class Index>
+        void input_write(const basic_graph<Weight, Index>& val) {
             _eil();
-            input_write(val.to_string());
+            Format::write(*fin, val);
         }
-        void output_write(graph val) {
+        template <class Format = graph_format::weighted, class Weight, class Index>
+        void output_write(const basic_graph<Weight, Index>& val) {
             _eil();
-            output_write(val.to_string());
+            Format::write(*fout, val);
         }
 
-        void input_write(edge val) {
+        template <class Format = graph_format::weighted, class Weight, class Index>
+        void input_write(const basic_edge<Weight, Index>& val) {
             _eil();
-            input_write(weighted_output()(val));
+            Format::write_edge(*fin, val);
         }
-        void output_write(edge val) {
+        template <class Format = graph_format::weighted, class Weight, class Index>
+        void output_write(const basic_edge<Weight, Index>& val) {
             _eil();
-            output_write(weighted_output()(val));
+            Format::write_edge(*fout, val);
         }
 
         template <class T, typename... Args>
-        void input_write(T val, Args... args) {
+        void input_write(const T& val, const Args&... args) {
             _eil();
             input_write(val);
             input_write(' ');
@@ -1189,32 +4743,60 @@ namespace carefree_internal {
         }
 
         template <class T, typename... Args>
-        void output_write(T val, Args... args) {
+        void output_write(const T& val, const Args&... args) {
             _eil();
             output_write(val);
             output_write(' ');
             output_write(args...);
         }
 
+        template <class Format, class... Args>
+        void inputf(Format, const Args&... args) {
+            using traits = _format_traits<Format>;
+            static_assert(traits::layout.valid, "inputf : unmatched brace in format string");
+            static_assert(traits::layout.placeholders == sizeof...(Args), "inputf : number of arguments does not match the format string");
+            _eil();
+            _putf<traits>(*fin, std::index_sequence_for<Args...>(), args...);
+        }
+        template <class Format, class... Args>
+        void outputf(Format, const Args&... args) {
+            using traits = _format_traits<Format>;
+            static_assert(traits::layout.valid, "outputf : unmatched brace in format string");
+            static_assert(traits::layout.placeholders == sizeof...(Args), "outputf : number of arguments does not match the format string");
+            _eil();
+            _putf<traits>(*fout, std::index_sequence_for<Args...>(), args...);
+        }
+
+#if __cplusplus >= 202002L
+        template <_fixed_format_string Format, class... Args>
+        void inputf(const Args&... args) {
+            inputf(_fixed_format<Format>(), args...);
+        }
+        template <_fixed_format_string Format, class... Args>
+        void outputf(const Args&... args) {
+            outputf(_fixed_format<Format>(), args...);
+        }
+#endif
+
         void input_writeln() { input_write('\n'); }
         void output_writeln() { output_write('\n'); }
 
         template <class T>
-        void input_writeln(T val) {
+        void input_writeln(const T& val) {
             _eil();
             input_write(val);
             input_write('\n');
         }
 
         template <class T>
-        void output_writeln(T val) {
+        void output_writeln(const T& val) {
             _eil();
             output_write(val);
             output_write('\n');
         }
 
         template <class T, typename... Args>
-        void input_writeln(T val, Args... args) {
+        void input_writeln(const T& val, const Args&... args) {
             _eil();
             input_write(val);
             input_write(' ');
@@ -1222,7 +4804,7 @@ namespace carefree_internal {
         }
 
         template <class T, typename... Args>
-        void output_writeln(T val, Args... args) {
+        void output_writeln(const T& val, const Args&... args) {
             _eil();
             output_write(val);
             output_write(' ');
@@ -1231,22 +4813,97 @@ namespace carefree_internal {
 
         bool is_locked() { return locked; }
 
+        void set_precision(int precision) {
+            err_natural_checker(precision, __func__, "precision");
+            fin->setPrecision(precision);
+            fout->setPrecision(precision);
+        }
+
+        void set_size_hint(unsigned long long input_size, unsigned long long output_size = 0) {
+            if (input_size) fin->reserve(input_size);
+            if (output_size) fout->reserve(output_size);
+        }
+
+        void set_max_size(unsigned long long max_size) {
+            this->max_size = max_size;
+            fin->setLimit(max_size);
+            fout->setLimit(max_size);
+        }
+
+        unsigned long long input_bytes_written() {
+            return fin->bytesWritten();
+        }
+
+        unsigned long long output_bytes_written() {
+            return locked && archive == nullptr ? _file_size(fout->_filename) : fout->bytesWritten();
+        }
+
+        void set_async(bool enable = true) {
+            fin->set_async(enable);
+            fout->set_async(enable);
+        }
+
         void input_flush() { fin->flush(); }
         void output_flush() { fout->flush(); }
 
         void output_gen(string program) {
             _eil();
+            if (archive != nullptr) raise(carefree_unsupported_operation("testcase_writer::output_gen : archived testcases can only be generated by start_output_gen."));
+            if (runner) raise(carefree_unsupported_operation("testcase_writer::output_gen : a program is already attached, use wait_output_gen."));
             fin->close();
             fout->close();
             lock();
-            int stdin_ = dup(fileno(stdin));
-            freopen(fin->_filename.c_str(), "r", stdin);
-            int stdout_ = dup(fileno(stdout));
-            freopen(fout->_filename.c_str(), "w", stdout);
-            int returnid = std::system(program.c_str());
+            _std_process process;
+            process.start(program, fin->_filename, fout->_filename);
+            int returnid = process.wait();
+            if (returnid != 0) raise(carefree_runtime_exception("testcase_writer::output_gen :  program exited with non-zero return code"));
+            _check_output_size("testcase_writer::output_gen");
+        }
+
+        void output_gen(shared_solution& solution, bool isolate = false) {
+            _eil();
+            if (archive != nullptr) raise(carefree_unsupported_operation("testcase_writer::output_gen : archived testcases can only be generated by start_output_gen."));
+            if (runner) raise(carefree_unsupported_operation("testcase_writer::output_gen : a program is already attached, use wait_output_gen."));
+            fin->close();
+            lock();
+            string output;
+            int returnid = solution.run(_read_file(fin->_filename, "testcase_writer::output_gen"), output, isolate);
+            fout->writeString(output);
+            fout->close();
             if (returnid != 0) raise(carefree_runtime_exception("testcase_writer::output_gen :  program exited with non-zero return code"));
-            dup2(stdin_, fileno(stdin));
-            dup2(stdout_, fileno(stdout));
+        }
+
+        void start_output_gen(string program) {
+            _eil();
+            if (runner) raise(carefree_unsupported_operation("testcase_writer::start_output_gen : a program is already attached."));
+            if (fin->bytesWritten()) raise(carefree_unsupported_operation("testcase_writer::start_output_gen : input has already been written."));
+            spool = archive == nullptr ? "" : archive->_temporary_name();
+            if (archive == nullptr) fout->close();
+            runner.reset(new _std_process());
+            runner->start(program, "", archive == nullptr ? fout->_filename : spool);
+            fin->setTee(runner->input());
+        }
+
+        void wait_output_gen() {
+            if (!runner) raise(carefree_unsupported_operation("testcase_writer::wait_output_gen : no program is attached."));
+            fin->close();
+            lock();
+            int returnid = runner->wait();
+            runner.reset();
+            if (!spool.empty()) {
+                FILE* file = std::fopen(spool.c_str(), "rb");
+                if (file != nullptr) {
+                    char block[1 << 16];
+                    size_t length;
+                    while ((length = std::fread(block, 1, sizeof(block), file)) != 0) fout->writeString(block, length);
+                    std::fclose(file);
+                }
+                std::remove(spool.c_str());
+                spool.clear();
+                fout->close();
+            }
+            if (returnid != 0) raise(carefree_runtime_exception("testcase_writer::wait_output_gen : program exited with non-zero return code"));
+            _check_output_size("testcase_writer::wait_output_gen");
         }
 
         string input_name() {
@@ -1262,6 +4919,7 @@ namespace carefree_internal {
             delete fout;
             fin = nullptr;
             fout = nullptr;
+            runner.reset();
         }
 
         ~testcase_writer() {
@@ -1272,6 +4930,38 @@ namespace carefree_internal {
 
     using testcase_io [[deprecated("use testcase_writer instead.")]] = testcase_writer;
 
+    template <class Format = graph_format::weighted>
+    class writer_sink {
+    private:
+        testcase_writer* io;
+        bool output, first;
+
+    public:
+        writer_sink(testcase_writer& io, bool output = false) : io(&io), output(output), first(true) {}
+
+        template <class Weight>
+        void operator()(int from, int to, const Weight& weight) {
+            if (output) {
+                if (!first) io->output_write('\n');
+                io->output_write<Format>(basic_edge<Weight>(from, to, weight));
+            } else {
+                if (!first) io->input_write('\n');
+                io->input_write<Format>(basic_edge<Weight>(from, to, weight));
+            }
+            first = false;
+        }
+    };
+
+    template <class Format = graph_format::weighted>
+    writer_sink<Format> input_sink(testcase_writer& io) {
+        return writer_sink<Format>(io, false);
+    }
+
+    template <class Format = graph_format::weighted>
+    writer_sink<Format> output_sink(testcase_writer& io) {
+        return writer_sink<Format>(io, true);
+    }
+
     class luogu_testcase_config_writer {
     private:
         string content;
@@ -1300,6 +4990,10 @@ namespace carefree_internal {
             if (fclose(fobj) != 0) raise(carefree_file_exception("luogu_testcase_config_writer::save : failed to close file " + filename));
         }
 
+        void save(zip_archive& archive, string filename = "config.yml") {
+            archive.add(filename, content);
+        }
+
         string to_string() {
             return content;
         }
@@ -1893,7 +5587,7 @@ namespace carefree_internal {
         optimization_type opti = O2;
         cpp_version cpp = Cpp14;
         cpp_warnings::type warning = 0;
-        bool link_static = false, debug = false;
+        bool link_static = false, debug = false, shared = false;
         std::vector<string> include_files, include_dirs, link_libs;
         std::map<string, string> defintions;
 
@@ -1955,6 +5649,11 @@ namespace carefree_internal {
             return *this;
         }
 
+        gcc_compile& shared_library(bool shared = true) {
+            this->shared = shared;
+            return *this;
+        }
+
         string command() {
             string cmd = gcc_path + " " + quote(filename);
             if (debug) {
@@ -2037,6 +5736,10 @@ namespace carefree_internal {
                 cmd += " -static";
             }
 
+            if (shared) {
+                cmd += " -shared";
+            }
+
             cmd += " -o " + quote(output_name);
 
             return cmd;
@@ -2267,7 +5970,16 @@ namespace carefree_internal {
 
 namespace carefree {
     using carefree_internal::_base_exception;
+    using carefree_internal::attach;
     using carefree_internal::autoclear_tmpfiles;
+    using carefree_internal::basic_csr;
+    using carefree_internal::basic_csr_view;
+    using carefree_internal::basic_edge;
+    using carefree_internal::basic_graph;
+    using carefree_internal::basic_graph_builder;
+    using carefree_internal::basic_mapped_graph;
+    using carefree_internal::basic_tree_info;
+    using carefree_internal::bfs01;
     using carefree_internal::binary_tree;
     using carefree_internal::carefree_exception;
     using carefree_internal::carefree_file_exception;
@@ -2289,8 +6001,13 @@ namespace carefree {
     using carefree_internal::connected_undirected_graph;
     using carefree_internal::cpp_version;
     using carefree_internal::creadable;
+    using carefree_internal::csr;
+    using carefree_internal::csr_view;
     using carefree_internal::ctext;
     using carefree_internal::dag;
+    using carefree_internal::degree_sequence;
+    using carefree_internal::dijkstra;
+    using carefree_internal::disjoint_union;
     using carefree_internal::edge;
     using carefree_internal::ES;
     using carefree_internal::exception_policy;
@@ -2303,24 +6020,49 @@ namespace carefree {
     using carefree_internal::get_depth;
     using carefree_internal::get_exception_policy;
     using carefree_internal::graph;
+    using carefree_internal::graph_builder;
+    using carefree_internal::graph_sink;
+    using carefree_internal::graph_validator;
+    using carefree_internal::havel_hakimi;
     using carefree_internal::helloworld;
+    using carefree_internal::input_sink;
     using carefree_internal::introvert;
+    using carefree_internal::is_acyclic;
+    using carefree_internal::is_bipartite;
+    using carefree_internal::is_connected;
+    using carefree_internal::is_dag;
+    using carefree_internal::is_graphical;
+    using carefree_internal::is_simple;
     using carefree_internal::is_tree;
+    using carefree_internal::join_by_edges;
     using carefree_internal::jrt2s;
     using carefree_internal::jrt2sf;
     using carefree_internal::judge;
     using carefree_internal::judge_result;
     using carefree_internal::judge_result_type;
+    using carefree_internal::k_regular;
+    using carefree_internal::kruskal;
     using carefree_internal::limited_run;
     using carefree_internal::limprog;
     using carefree_internal::listdir;
     using carefree_internal::lowhigh;
     using carefree_internal::ltv;
     using carefree_internal::luogu_testcase_config_writer;
+    using carefree_internal::mapped_graph;
     using carefree_internal::max_degree;
     using carefree_internal::naive_tree;
     using carefree_internal::nextid;
+    using carefree_internal::no_weight;
     using carefree_internal::optimization_type;
+    using carefree_internal::output_sink;
+    using carefree_internal::parallel_lowhigh;
+    using carefree_internal::parallel_random_tree;
+    using carefree_internal::parallel_relabel;
+    using carefree_internal::parallel_shuffle;
+    using carefree_internal::parallel_shuffle_edges;
+    using carefree_internal::parallel_sort;
+    using carefree_internal::parallel_tail;
+    using carefree_internal::prim;
     using carefree_internal::process;
     using carefree_internal::process_base;
     using carefree_internal::prufer_decode;
@@ -2332,11 +6074,35 @@ namespace carefree {
     using carefree_internal::random_tree;
     using carefree_internal::randstr;
     using carefree_internal::relabel;
+    using carefree_internal::relabel_sink;
+    using carefree_internal::relabeled;
+    using carefree_internal::sample_distinct;
+    using carefree_internal::scc;
     using carefree_internal::sequence;
     using carefree_internal::set_exception_policy;
+    using carefree_internal::shared_solution;
     using carefree_internal::shuffle;
     using carefree_internal::silkworm;
     using carefree_internal::star;
+    using carefree_internal::stream_binary_tree;
+    using carefree_internal::stream_chain;
+    using carefree_internal::stream_chain_star;
+    using carefree_internal::stream_complete;
+    using carefree_internal::stream_complete_binary;
+    using carefree_internal::stream_dag;
+    using carefree_internal::stream_degree_sequence;
+    using carefree_internal::stream_firecrackers;
+    using carefree_internal::stream_flower;
+    using carefree_internal::stream_havel_hakimi;
+    using carefree_internal::stream_k_regular;
+    using carefree_internal::stream_lowhigh;
+    using carefree_internal::stream_max_degree;
+    using carefree_internal::stream_naive_tree;
+    using carefree_internal::stream_prufer_decode;
+    using carefree_internal::stream_random_tree;
+    using carefree_internal::stream_silkworm;
+    using carefree_internal::stream_star;
+    using carefree_internal::stream_tail;
     using carefree_internal::strict_comparator;
     using carefree_internal::strict_comparator_naive;
     using carefree_internal::tail;
@@ -2345,11 +6111,16 @@ namespace carefree {
     using carefree_internal::testlib_comparator;
     using carefree_internal::timer;
     using carefree_internal::token_comparator;
+    using carefree_internal::tree_info;
     using carefree_internal::uniform;
     using carefree_internal::unweighted_output;
     using carefree_internal::weighted_output;
     using carefree_internal::working_directory;
+    using carefree_internal::writer_sink;
+    using carefree_internal::zip_archive;
 
+    namespace graph_format = carefree_internal::graph_format;
+    namespace weights = carefree_internal::weights;
     namespace strsets = carefree_internal::strsets;
     namespace cpp_warnings = carefree_internal::cpp_warnings;
     namespace pred = carefree_internal::pred;